@@ -0,0 +1,32 @@
+#include "AnimationClip.h"
+
+//Constructor
+AnimationClip::AnimationClip(SDL_Rect firstFrame, Uint32 numOfFrames, Uint32 frameDelay, int sheetWidth){
+	miFrameDelay = frameDelay ? frameDelay : 1;
+	//Walk the spritesheet row by row
+	SDL_Rect frame = firstFrame;
+	for(Uint32 i = 0; i < numOfFrames; ++i){
+		mFrames.push_back(frame);
+		if(frame.x+frame.w < sheetWidth) frame.x+=frame.w;
+		else {
+			frame.x = 0;
+			frame.y+=frame.h;
+		}
+	}
+	if(mFrames.empty()) mFrames.push_back(firstFrame);
+}
+
+//Frame at current time
+SDL_Rect AnimationClip::getFrame(Uint32 phase) const {
+	return getFrameAt((Clock::now()-phase)/miFrameDelay);
+}
+
+//Frame by index
+SDL_Rect AnimationClip::getFrameAt(Uint32 frame) const {
+	return mFrames[frame%mFrames.size()];
+}
+
+//Clip length
+Uint32 AnimationClip::getLength() const {
+	return mFrames.size()*miFrameDelay;
+}
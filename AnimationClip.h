@@ -0,0 +1,49 @@
+///Shared animation clip
+
+#ifndef ANIMATIONCLIP_H
+#define ANIMATIONCLIP_H
+
+///Include SDL modules
+#include <SDL2/SDL.h>
+
+///Include local modules
+#include "Clock.h"
+
+///Misc library inclusion
+#include <vector>
+using std::vector;
+
+class AnimationClip{
+public:
+
+	///Constructor (precomputes the frame table)
+	///Args:
+	///SDL_Rect firstFrame - size and location of first frame
+	///Uint32 numOfFrames - number of frames
+	///Uint32 frameDelay - time per frame (in ms)
+	///int sheetWidth - spritesheet width (frames wrap to the next row)
+	AnimationClip(SDL_Rect firstFrame, Uint32 numOfFrames, Uint32 frameDelay, int sheetWidth);
+
+	///Get frame rectangle for the current frame time
+	///Args:
+	///Uint32 phase - instance start time (in ms)
+	SDL_Rect getFrame(Uint32 phase = 0) const;
+
+	///Get frame rectangle by index
+	///Args:
+	///Uint32 frame - frame index (wraps around)
+	SDL_Rect getFrameAt(Uint32 frame) const;
+
+	///Clip length (in ms)
+	Uint32 getLength() const;
+
+private:
+
+	///Frame rectangles
+	vector<SDL_Rect> mFrames;
+
+	///Time per frame
+	Uint32 miFrameDelay;
+};
+
+#endif
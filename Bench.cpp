@@ -0,0 +1,353 @@
+///bench - micro-benchmarks of the rules, pawn rendering, recovery files, constants and textures
+///Usage: bench [--filter TEXT] [--runs N] [--out FILE] [--label TEXT] [--compare FILE]
+///Run from the game folder (GFX/ and Constants.xml are read), the recovery benchmarks
+///write their Recovery.xml to a temporary folder
+
+#include "Engine.h"
+#include "Player.h"
+#include "Recovery.h"
+#include "Texture.h"
+#include "pugixml.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <unistd.h>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+//Discarded runs before measuring
+#define WARMUP_RUNS 3
+
+//Shortest measured run (ms), the batch size grows until a run takes this long
+#define MIN_RUN_MS 20
+
+//Benchmark (runs the operation n times)
+struct Benchmark{
+	const char* name;
+	std::function<void(long long)> run;
+};
+
+//Measured nanoseconds per operation
+struct Summary{
+	string name;
+	long long batch;
+	vector<double> samples;
+	double median, mean, stddev, min, max, interval;
+};
+
+//Results the compiler may not drop
+static volatile unsigned gSink;
+
+//Time one run (ns per operation)
+static double timeRun(const Benchmark& b, long long batch){
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	b.run(batch);
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now()-start).count()/batch;
+}
+
+//Calibrate, warm up and measure a benchmark
+static Summary measure(const Benchmark& b, int runs){
+	Summary s;
+	s.name = b.name;
+	s.batch = 1;
+	while(timeRun(b, s.batch)*s.batch<MIN_RUN_MS*1e6 && s.batch<(1LL<<40)) s.batch *= 2;
+	for(int i = 0; i < WARMUP_RUNS; ++i) timeRun(b, s.batch);
+	for(int i = 0; i < runs; ++i) s.samples.push_back(timeRun(b, s.batch));
+
+	vector<double> sorted = s.samples;
+	std::sort(sorted.begin(), sorted.end());
+	s.median = runs%2 ? sorted[runs/2] : (sorted[runs/2-1]+sorted[runs/2])/2;
+	s.min = sorted.front();
+	s.max = sorted.back();
+	s.mean = 0;
+	for(int i = 0; i < runs; ++i) s.mean += sorted[i]/runs;
+	double variance = 0;
+	for(int i = 0; i < runs; ++i) variance += (sorted[i]-s.mean)*(sorted[i]-s.mean)/std::max(runs-1, 1);
+	s.stddev = sqrt(variance);
+	//95% interval of the mean
+	s.interval = 1.96*s.stddev/sqrt((double)runs);
+	return s;
+}
+
+//Readable time
+static string format(double ns){
+	char text[32];
+	if(ns<1e3) snprintf(text, sizeof(text), "%.1f ns", ns);
+	else if(ns<1e6) snprintf(text, sizeof(text), "%.2f us", ns/1e3);
+	else snprintf(text, sizeof(text), "%.2f ms", ns/1e6);
+	return text;
+}
+
+//JSON string contents (quotes, backslashes and control characters escaped)
+static string escape(const string& text){
+	string escaped;
+	for(unsigned i = 0; i < text.size(); ++i){
+		unsigned char c = text[i];
+		if(c=='"' || c=='\\'){
+			escaped += '\\';
+			escaped += c;
+		}
+		else if(c<0x20){
+			char code[8];
+			snprintf(code, sizeof(code), "\\u%04x", c);
+			escaped += code;
+		}
+		else escaped += c;
+	}
+	return escaped;
+}
+
+//Read medians and intervals of an earlier result file
+static std::map<string, pair<double, double> > readResults(const string& path){
+	std::map<string, pair<double, double> > results;
+	std::ifstream in(path.c_str());
+	string line;
+	while(getline(in, line)){
+		//One benchmark per line: {"name":"...", ..., "median_ns":X, ..., "ci95_ns":Y, ...}
+		size_t name = line.find("\"name\":\"");
+		size_t median = line.find("\"median_ns\":");
+		size_t interval = line.find("\"ci95_ns\":");
+		if(name==string::npos || median==string::npos || interval==string::npos) continue;
+		//Undo the escaped quotes and backslashes of escape()
+		string text;
+		for(name += 8; name<line.size() && line[name]!='"'; ++name){
+			if(line[name]=='\\' && name+1<line.size()) ++name;
+			text += line[name];
+		}
+		results[text] = std::make_pair(atof(line.c_str()+median+12), atof(line.c_str()+interval+10));
+	}
+	return results;
+}
+
+
+
+
+//Engine positions before a move and the moved pawn
+struct Position{
+	Engine engine;
+	int pawn;
+};
+
+//Collect positions of random games (moves without and with a capture)
+static void collectPositions(vector<Position>& moves, vector<Position>& captures, vector<Engine>& rolled){
+	std::minstd_rand random(1);
+	vector<Colors> order;
+	for(int i = 0; i < PLAYERS; ++i) order.push_back(Colors(i+1));
+	while(moves.size()<1000 || captures.size()<1000){
+		Engine engine;
+		engine.newGame(order);
+		while(!engine.isOver() && (moves.size()<1000 || captures.size()<1000)){
+			engine.setRoll(random()%6+1);
+			vector<int> legal = engine.getMoves();
+			if(legal.empty()){
+				engine.move(PASS);
+				continue;
+			}
+			if(rolled.size()<1000) rolled.push_back(engine);
+			Position p = {engine, legal[random()%legal.size()]};
+			int taken = engine.getPlayers().front().taken;
+			engine.move(p.pawn);
+			//The mover stays first after a 6
+			int takenNow = 0;
+			for(unsigned i = 0; i < engine.getPlayers().size(); ++i)
+				if(engine.getPlayers()[i].color==p.engine.getCurrent()) takenNow = engine.getPlayers()[i].taken;
+			vector<Position>& list = takenNow>taken ? captures : moves;
+			if(list.size()<1000) list.push_back(p);
+		}
+	}
+}
+
+//Players of a game in progress (two pawns stacked on one square)
+static deque<Player*> makePlayers(){
+	deque<Player*> players;
+	for(int i = 0; i < PLAYERS; ++i){
+		Player* p = new Player(Colors(i+1));
+		for(unsigned j = 0; j < p->m_vPawns.size(); ++j){
+			p->m_vPawns[j]->setIPosition(j ? 5*j+i : 0);
+			p->m_vPawns[j]->setIXPosition(j==2 ? 6 : (int)j+i);
+			p->m_vPawns[j]->setIYPosition(j==2 ? 1 : 6);
+		}
+		p->setIActivePawns(PAWNS-1);
+		p->setISteps(40+i);
+		players.push_back(p);
+	}
+	return players;
+}
+
+
+
+
+int main(int argc, char* argv[]){
+	string filter, outPath = "bench.json", label, comparePath;
+	int runs = 15;
+
+	//Read command line options
+	for(int i = 1; i < argc; ++i){
+		string arg = argv[i];
+		if(arg=="--filter" && i+1<argc) filter = argv[++i];
+		else if(arg=="--runs" && i+1<argc) runs = atoi(argv[++i]);
+		else if(arg=="--out" && i+1<argc) outPath = argv[++i];
+		else if(arg=="--label" && i+1<argc) label = argv[++i];
+		else if(arg=="--compare" && i+1<argc) comparePath = argv[++i];
+		else runs = 0;
+	}
+	if(runs<2){
+		cerr << "Usage: " << argv[0] << " [--filter TEXT] [--runs N] [--out FILE] [--label TEXT] [--compare FILE]" << endl;
+		return 1;
+	}
+
+	//Render into memory (no window)
+	SDL_Surface* target = SDL_CreateRGBSurfaceWithFormat(0, WIDTH, HEIGHT, 32, SDL_PIXELFORMAT_RGBA8888);
+	Texture::mRenderer = target ? SDL_CreateSoftwareRenderer(target) : NULL;
+	if(Texture::mRenderer==NULL){
+		cerr << "Bench error: " << SDL_GetError() << endl;
+		return 1;
+	}
+
+	//Pawn sheet (loaded before leaving the game folder)
+	Pawn::loadSheet();
+	deque<Player*> players = makePlayers();
+	vector<Position> moves, captures;
+	vector<Engine> rolled;
+	collectPositions(moves, captures, rolled);
+
+	//Absolute paths of the game files (the benchmarks run in a temporary folder)
+	char cwd[4096];
+	if(!getcwd(cwd, sizeof(cwd))) return 1;
+	string root = string(cwd)+"/";
+	char tempDir[] = "/tmp/ludo-bench-XXXXXX";
+	if(!mkdtemp(tempDir) || chdir(tempDir)!=0){
+		cerr << "Bench error: cannot create a temporary folder" << endl;
+		return 1;
+	}
+	//Screen positions of one player (pawns share squares in pairs)
+	vector<pair<int,int> > screen;
+	for(int i = 0; i < PAWNS; ++i) screen.push_back(std::make_pair(300+60*(i/2), 300));
+	Texture texture;
+
+	vector<Benchmark> benchmarks;
+	//Copy of a position (part of the move and capture benchmarks)
+	benchmarks.push_back(Benchmark{"engine.copy", [&](long long n){
+		for(long long i = 0; i < n; ++i){
+			Engine e = moves[i%moves.size()].engine;
+			gSink += e.getTurn();
+		}
+	}});
+	//Pawn move without capture (the rules of Game::movePawn)
+	benchmarks.push_back(Benchmark{"engine.move", [&](long long n){
+		for(long long i = 0; i < n; ++i){
+			const Position& p = moves[i%moves.size()];
+			Engine e = p.engine;
+			gSink += e.move(p.pawn);
+		}
+	}});
+	//Pawn move with capture (the rules of Game::collision)
+	benchmarks.push_back(Benchmark{"engine.capture", [&](long long n){
+		for(long long i = 0; i < n; ++i){
+			const Position& p = captures[i%captures.size()];
+			Engine e = p.engine;
+			gSink += e.move(p.pawn);
+		}
+	}});
+	//Legal move generation
+	benchmarks.push_back(Benchmark{"engine.moves", [&](long long n){
+		for(long long i = 0; i < n; ++i) gSink += rolled[i%rolled.size()].getMoves().size();
+	}});
+	//Pawn grouping by square and drawing
+	benchmarks.push_back(Benchmark{"player.render", [&](long long n){
+		for(long long i = 0; i < n; ++i) players[i%players.size()]->Render(screen);
+	}});
+	//Recovery file save and load
+	benchmarks.push_back(Benchmark{"recovery.write", [&](long long n){
+		for(long long i = 0; i < n; ++i) Recovery::WriteXML(players, i%2);
+	}});
+	static Player slots[PLAYERS];
+	deque<Player*> loaded;
+	benchmarks.push_back(Benchmark{"recovery.read", [&](long long n){
+		for(long long i = 0; i < n; ++i){
+			Recovery::ReadFromXML(slots, loaded);
+			gSink += loaded.size();
+		}
+	}});
+	//Constants.xml parse (the configuration read by constgen and hot reloading)
+	benchmarks.push_back(Benchmark{"constants.parse", [&](long long n){
+		for(long long i = 0; i < n; ++i){
+			pugi::xml_document doc;
+			gSink += doc.load_file((root+"Constants.xml").c_str());
+		}
+	}});
+	//Image decode and texture upload
+	benchmarks.push_back(Benchmark{"texture.load", [&](long long n){
+		for(long long i = 0; i < n; ++i){
+			texture.load(root+BOARD_PATH);
+			gSink += texture.getWidth();
+		}
+	}});
+
+	//Measure
+	vector<Summary> results;
+	for(unsigned i = 0; i < benchmarks.size(); ++i){
+		if(string(benchmarks[i].name).find(filter)==string::npos) continue;
+		//The recovery file is read from the last write
+		if(string(benchmarks[i].name)=="recovery.read") Recovery::WriteXML(players);
+		results.push_back(measure(benchmarks[i], runs));
+		const Summary& s = results.back();
+		printf("%-16s %12s +-%-10s (min %s, max %s, %lld per run)\n", s.name.c_str(), format(s.median).c_str(),
+		       format(s.interval).c_str(), format(s.min).c_str(), format(s.max).c_str(), s.batch);
+	}
+
+	//Clean up
+	while(!players.empty()){
+		delete players.back();
+		players.pop_back();
+	}
+	remove("Recovery.xml");
+	if(chdir(cwd)!=0 || rmdir(tempDir)!=0) cerr << "Bench error: cannot remove " << tempDir << endl;
+
+	//Compare with earlier results (changes within both intervals are noise)
+	if(!comparePath.empty()){
+		std::map<string, pair<double, double> > before = readResults(comparePath);
+		cout << endl << "Compared with " << comparePath << ":" << endl;
+		for(unsigned i = 0; i < results.size(); ++i){
+			std::map<string, pair<double, double> >::iterator old = before.find(results[i].name);
+			if(old==before.end()) continue;
+			double change = (results[i].median-old->second.first)/old->second.first*100;
+			bool noise = fabs(results[i].median-old->second.first)<=results[i].interval+old->second.second;
+			printf("%-16s %+7.1f%% %s\n", results[i].name.c_str(), change, noise ? "(noise)" : change<0 ? "faster" : "slower");
+		}
+	}
+
+	//Write results (one benchmark per line)
+	FILE* out = fopen(outPath.c_str(), "w");
+	if(out==NULL){
+		cerr << "Bench error: cannot write " << outPath << endl;
+		return 1;
+	}
+	char date[32];
+	time_t now = time(NULL);
+	strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+	fprintf(out, "{\"label\":\"%s\",\"date\":\"%s\",\"runs\":%d,\"warmup\":%d,\"benchmarks\":[\n",
+	        escape(label).c_str(), date, runs, WARMUP_RUNS);
+	for(unsigned i = 0; i < results.size(); ++i){
+		const Summary& s = results[i];
+		fprintf(out, "{\"name\":\"%s\",\"batch\":%lld,\"median_ns\":%.3f,\"mean_ns\":%.3f,\"stddev_ns\":%.3f,"
+		        "\"min_ns\":%.3f,\"max_ns\":%.3f,\"ci95_ns\":%.3f,\"samples_ns\":[",
+		        escape(s.name).c_str(), s.batch, s.median, s.mean, s.stddev, s.min, s.max, s.interval);
+		for(unsigned j = 0; j < s.samples.size(); ++j) fprintf(out, "%s%.3f", j ? "," : "", s.samples[j]);
+		fprintf(out, "]}%s\n", i+1<results.size() ? "," : "");
+	}
+	fprintf(out, "]}\n");
+	fclose(out);
+	cout << "Results written to " << outPath << endl;
+	return 0;
+}
@@ -90,10 +90,7 @@ void Button::setSFX(SEFFECTS sfx){
 bool Button::isClicked(SDL_Event & e){
     if(e.type == SDL_MOUSEBUTTONDOWN){
 		if(e.button.button == SDL_BUTTON_LEFT){
-			int x,y;
-			SDL_GetMouseState(&x, &y);
-			bool state = (x>=mButtonBase.x && x<=mButtonBase.x+mButtonBase.w &&
-					y>=mButtonBase.y && y<=mButtonBase.y+mButtonBase.h);
+			bool state = contains(e.button.x, e.button.y);
 			//Play SFX on click
 			if(state && mbHasSFX) Sound::play(meSFX);
 			return state;
@@ -106,10 +103,7 @@ bool Button::isClicked(SDL_Event & e){
 bool Button::isReleased(SDL_Event & e){
     if(e.type == SDL_MOUSEBUTTONUP){
 		if(e.button.button == SDL_BUTTON_LEFT){
-			int x,y;
-			SDL_GetMouseState(&x, &y);
-			return (x>=mButtonBase.x && x<=mButtonBase.x+mButtonBase.w &&
-					y>=mButtonBase.y && y<=mButtonBase.y+mButtonBase.h);
+			return contains(e.button.x, e.button.y);
 		}
 	}
 	return 0;
@@ -118,15 +112,22 @@ bool Button::isReleased(SDL_Event & e){
 //Button hover check
 bool Button::isOver(SDL_Event& e){
 	if(e.type == SDL_MOUSEMOTION){
-		int x,y;
-		SDL_GetMouseState(&x, &y);
-		return (x>=mButtonBase.x && x<=mButtonBase.x+mButtonBase.w &&
-					y>=mButtonBase.y && y<=mButtonBase.y+mButtonBase.h);
-
+		return contains(e.motion.x, e.motion.y);
 	}
 	return 0;
 }
 
+//Point check
+bool Button::contains(int x, int y) const {
+	return (x>=mButtonBase.x && x<=mButtonBase.x+mButtonBase.w &&
+			y>=mButtonBase.y && y<=mButtonBase.y+mButtonBase.h);
+}
+
+//Button rectangle getter
+SDL_Rect Button::getRect() const {
+	return mButtonBase;
+}
+
 //Render button
 void Button::render(){
 	if(mbIsFadingIn) fadeIn(mfFactor);
@@ -76,6 +76,15 @@ public:
 	///Args:
 	///SDL_Event& e - reference to SDL_Event instance
 	bool isOver(SDL_Event& e);
+
+	///Point check
+	///Args:
+	///int x - X screen coordinate
+	///int y - Y screen coordinate
+	bool contains(int x, int y) const;
+
+	///Button rectangle getter
+	SDL_Rect getRect() const;
 	
 	///Render button
 	void render();
@@ -0,0 +1,44 @@
+#include "Clock.h"
+
+Uint32 Clock::miNow = 0;
+Uint32 Clock::miDelta = 0;
+Uint32 Clock::miStart = 0;
+Uint32 Clock::miLast = 0;
+bool Clock::mbPaced = 1;
+
+void Clock::start(bool paced){
+	mbPaced = paced;
+	miStart = miLast = SDL_GetTicks();
+}
+
+bool Clock::tick(){
+	Uint32 dt;
+	if(Replay::isPlaying()){
+		//Use recorded frame duration
+		if(!Replay::nextFrame(dt)) return 0;
+		//Wait until the frame is due
+		if(mbPaced)
+			while(SDL_GetTicks()-miStart < miNow+dt) SDL_Delay(1);
+	} else {
+		//Measure real frame duration
+		Uint32 ticks = SDL_GetTicks();
+		dt = ticks-miLast;
+		miLast = ticks;
+		Replay::beginFrame(dt);
+	}
+	miDelta = dt;
+	miNow += dt;
+	return 1;
+}
+
+Uint32 Clock::now(){
+	return miNow;
+}
+
+Uint32 Clock::delta(){
+	return miDelta;
+}
+
+Uint32 Clock::elapsed(){
+	return SDL_GetTicks()-miStart;
+}
@@ -0,0 +1,45 @@
+///Frame clock (live time, or recorded frame times during replay playback)
+
+#ifndef CLOCK_H
+#define CLOCK_H
+
+///Include SDL modules
+#include <SDL2/SDL.h>
+
+///Include local modules
+#include "Replay.h"
+
+class Clock{
+public:
+
+	///Reset the clock
+	///Args:
+	///bool paced - keep the recorded pace during playback
+	static void start(bool paced = 1);
+
+	///Start a new frame
+	///(returns 0 when a played recording has ended)
+	static bool tick();
+
+	///Current frame time (in ms, fixed for the whole frame)
+	static Uint32 now();
+
+	///Last frame duration (in ms)
+	static Uint32 delta();
+
+	///Real time since start (in ms)
+	static Uint32 elapsed();
+
+private:
+
+	///Frame time and duration
+	static Uint32 miNow, miDelta;
+
+	///Real time of start and of the last frame
+	static Uint32 miStart, miLast;
+
+	///Playback pacing flag
+	static bool mbPaced;
+};
+
+#endif
@@ -0,0 +1,369 @@
+///Constants header generator
+///Compiles Constants.xml into a header of constexpr values, so the
+///board tables are compile-time constants and no XML is read at runtime.
+///Usage: ./constgen [input XML] [output header]
+
+#include "pugixml.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <map>
+#include <cstdlib>
+#include <cstring>
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::string;
+using std::stringstream;
+using std::ifstream;
+using std::ofstream;
+using std::map;
+#include <vector>
+using std::vector;
+
+//-----------------------------
+//-----------TABLES------------
+//-----------------------------
+
+//Table layouts found in Constants.xml
+enum Shapes{
+	SCALAR_LIST,	//Entries holding a single value
+	POINT_LIST,		//Entries holding <x> and <y>
+	POINT_GRID,		//Entries holding a list of <x>/<y> entries
+	FLAG_GRID,		//<ROW> holding one flag attribute per column
+	OFFSET_GRID,	//<ROW> holding <PAIR first="" second=""/> entries
+	PAIR_ROWS		//<ROW> holding <PAIR><first/><second/></PAIR> entries
+};
+
+//Table description
+struct Table{
+	const char* name;	//Element name
+	Shapes shape;		//Layout
+	const char* type;	//C++ element type
+	const char* rows;	//Row count constant
+	const char* cols;	//Column count constant (2D tables)
+};
+
+//Every table in Constants.xml (anything else is a scalar constant)
+const Table TABLES[] = {
+	{"SPRITE_SCALE",	 SCALAR_LIST, "float",			"PAWNS",		NULL},
+	{"MOVEABLE_SQUARES", FLAG_GRID,	  "bool",			"BOARD_HEIGHT", "BOARD_WIDTH"},
+	{"NEXT_SQUARE",		 OFFSET_GRID, "pair<int, int>", "BOARD_HEIGHT", "BOARD_WIDTH"},
+	{"ACTIVE_SQUARES",	 PAIR_ROWS,	  "pair<int, int>", "BOARD_LENGTH", NULL},
+	{"START_POS",		 SCALAR_LIST, "unsigned",		"PLAYERS",		NULL},
+	{"IDLE_POS",		 POINT_LIST,  "pair<int, int>", "PLAYERS",		NULL},
+	{"NEXT_SAFE",		 POINT_LIST,  "pair<int, int>", "PLAYERS",		NULL},
+	{"SAFE_SQUARES",	 POINT_GRID,  "pair<int, int>", "PLAYERS",		"PAWNS"},
+	{"BASE_SQUARES",	 POINT_GRID,  "pair<int, int>", "PLAYERS",		"PAWNS"},
+	{"FINAL_SQUARES",	 POINT_LIST,  "pair<int, int>", "PLAYERS",		NULL},
+	{"START_SQUARES",	 POINT_LIST,  "pair<int, int>", "PLAYERS",		NULL},
+	{"ENTRY_SQUARES",	 POINT_LIST,  "pair<int, int>", "PLAYERS",		NULL},
+	{"PAWN_LAYOUT",		 POINT_LIST,  "pair<int, int>", "PAWNS",		NULL},
+	{"DICE_POS",		 POINT_LIST,  "pair<int, int>", "PLAYERS",		NULL},
+	{"SCREEN_COORDS",	 POINT_LIST,  "pair<int, int>", NULL,			NULL}
+};
+const int TABLES_NUM = sizeof(TABLES)/sizeof(TABLES[0]);
+
+//Scalars that can be reloaded at runtime in HOT_RELOAD builds
+//(asset paths, ending in _PATH, are always reloadable)
+const char* TUNABLES[] = {
+	"MOVEMENT_DELAY", "FADE_FACTOR",
+	"TRANSITION_DURATION", "TRANSITION_EASING",
+	"EXPLODE_FRAMES", "EXPLODE_DELAY",
+	"SHOCK_FRAMES", "SHOCK_DELAY"
+};
+const int TUNABLES_NUM = sizeof(TUNABLES)/sizeof(TUNABLES[0]);
+
+//-----------------------------
+//----------VARIABLES----------
+//-----------------------------
+
+//Integer constants read so far (used to check table sizes)
+map<string, long> gIntegers;
+
+//Error counter
+int gErrors = 0;
+
+//Reloadable scalar list entries
+vector<string> gTunables;
+
+//-----------------------------
+//----------FUNCTIONS----------
+//-----------------------------
+
+//Report an error in the source file
+void error(const string& what){
+	cerr << "constgen: " << what << endl;
+	gErrors++;
+}
+
+//Determine if a scalar can be reloaded at runtime
+bool isTunable(const string& name){
+	if(name.size()>5 && name.compare(name.size()-5, 5, "_PATH")==0) return 1;
+	for(int i = 0; i < TUNABLES_NUM; ++i)
+		if(name==TUNABLES[i]) return 1;
+	return 0;
+}
+
+//Find table description by element name
+const Table* findTable(const char* name){
+	for(int i = 0; i < TABLES_NUM; ++i)
+		if(!strcmp(TABLES[i].name, name)) return &TABLES[i];
+	return NULL;
+}
+
+//Trim whitespace
+string trim(const string& s){
+	size_t from = s.find_first_not_of(" \t\r\n");
+	if(from==string::npos) return string();
+	size_t to = s.find_last_not_of(" \t\r\n");
+	return s.substr(from, to-from+1);
+}
+
+//Parse an integer (decimal, 0x or 0b prefixed)
+bool parseInteger(const string& s, long& value){
+	if(s.empty()) return 0;
+	char* end;
+	if(s.size()>2 && s[0]=='0' && (s[1]=='b' || s[1]=='B'))
+		value = strtol(s.c_str()+2, &end, 2);
+	else
+		value = strtol(s.c_str(), &end, 0);
+	return *end=='\0';
+}
+
+//Parse a real number
+bool parseReal(const string& s, double& value){
+	if(s.empty()) return 0;
+	char* end;
+	value = strtod(s.c_str(), &end);
+	return *end=='\0';
+}
+
+//Get value of a node as a C++ literal
+string literal(const string& text, const char* type){
+	string s = trim(text);
+	stringstream out;
+	long integer;
+	double real;
+	//Integer values
+	if(!strcmp(type, "int") || !strcmp(type, "unsigned") || !strcmp(type, "bool")){
+		if(!parseInteger(s, integer)) error("\"" + s + "\" is not an integer");
+		if(!strcmp(type, "bool")) out << (integer ? 1 : 0);
+		else out << integer;
+	}
+	//Real values
+	else if(!strcmp(type, "float")){
+		if(!parseReal(s, real)) error("\"" + s + "\" is not a number");
+		out << real;
+	}
+	//Text values
+	else {
+		out << '"';
+		for(unsigned i = 0; i < s.size(); ++i){
+			if(s[i]=='"' || s[i]=='\\') out << '\\';
+			out << s[i];
+		}
+		out << '"';
+	}
+	return out.str();
+}
+
+//Guess the type of a scalar constant from its text
+const char* scalarType(const string& text){
+	string s = trim(text);
+	long integer;
+	double real;
+	if(parseInteger(s, integer)) return "int";
+	if(parseReal(s, real)) return "float";
+	return "const char*";
+}
+
+//Get a coordinate pair literal from an <x>/<y> node
+string point(pugi::xml_node n){
+	if(!n.child("x") || !n.child("y"))
+		error(string("<") + n.name() + "> has no <x>/<y> children");
+	return "{" + literal(n.child("x").text().as_string(), "int") + ", "
+		+ literal(n.child("y").text().as_string(), "int") + "}";
+}
+
+//Count element children
+int countChildren(pugi::xml_node n){
+	int count = 0;
+	for(pugi::xml_node c = n.first_child(); c; c = c.next_sibling()) count++;
+	return count;
+}
+
+//Check a table dimension against its size constant
+void checkSize(const Table& t, const char* constant, int found){
+	if(constant==NULL) return;
+	if(!gIntegers.count(constant)){
+		error(string(t.name) + " is sized by unknown constant " + constant);
+		return;
+	}
+	if(gIntegers[constant]!=found){
+		stringstream s;
+		s << t.name << " has " << found << " entries, " << constant << " is " << gIntegers[constant];
+		error(s.str());
+	}
+}
+
+//Emit a table
+void emitTable(const Table& t, pugi::xml_node n, stringstream& out){
+	stringstream body;
+	int rows = 0, cols = -1;
+
+	switch(t.shape){
+		case SCALAR_LIST:
+		case POINT_LIST:
+			for(pugi::xml_node e = n.first_child(); e; e = e.next_sibling(), ++rows){
+				body << "\t" << (t.shape==SCALAR_LIST ? literal(e.text().as_string(), t.type) : point(e))
+					<< (e.next_sibling() ? "," : " ") << " //" << e.name() << "\n";
+			}
+			break;
+
+		case POINT_GRID:
+			for(pugi::xml_node e = n.first_child(); e; e = e.next_sibling(), ++rows){
+				body << "\t{ ";
+				for(pugi::xml_node p = e.first_child(); p; p = p.next_sibling())
+					body << point(p) << (p.next_sibling() ? ", " : " ");
+				body << "}" << (e.next_sibling() ? "," : " ") << " //" << e.name() << "\n";
+				if(cols<0) cols = countChildren(e);
+				else if(cols!=countChildren(e)) error(string(t.name) + " has rows of different length");
+			}
+			break;
+
+		case FLAG_GRID:
+			for(pugi::xml_node e = n.first_child(); e; e = e.next_sibling(), ++rows){
+				int count = 0;
+				body << "\t{";
+				for(pugi::xml_attribute a = e.first_attribute(); a; a = a.next_attribute(), ++count)
+					body << literal(a.as_string(), t.type) << (a.next_attribute() ? "," : "");
+				body << "}" << (e.next_sibling() ? "," : "") << "\n";
+				if(cols<0) cols = count;
+				else if(cols!=count) error(string(t.name) + " has rows of different length");
+			}
+			break;
+
+		case OFFSET_GRID:
+			for(pugi::xml_node e = n.first_child(); e; e = e.next_sibling(), ++rows){
+				body << "\t{";
+				for(pugi::xml_node p = e.first_child(); p; p = p.next_sibling())
+					body << "{" << literal(p.attribute("first").as_string(), "int") << ","
+						<< literal(p.attribute("second").as_string(), "int") << "}"
+						<< (p.next_sibling() ? "," : "");
+				body << "}" << (e.next_sibling() ? "," : "") << "\n";
+				if(cols<0) cols = countChildren(e);
+				else if(cols!=countChildren(e)) error(string(t.name) + " has rows of different length");
+			}
+			break;
+
+		case PAIR_ROWS:
+			for(pugi::xml_node e = n.first_child(); e; e = e.next_sibling()){
+				body << "\t";
+				for(pugi::xml_node p = e.first_child(); p; p = p.next_sibling(), ++rows)
+					body << "{" << literal(p.child("first").text().as_string(), "int") << ","
+						<< literal(p.child("second").text().as_string(), "int") << "}"
+						<< ((p.next_sibling() || e.next_sibling()) ? ", " : "");
+				body << "\n";
+			}
+			break;
+	}
+
+	//Check sizes
+	checkSize(t, t.rows, rows);
+	if(cols>=0) checkSize(t, t.cols, cols);
+
+	//Array declaration
+	out << "constexpr " << t.type << " " << t.name << "[" << (t.rows ? t.rows : "");
+	if(t.cols) out << "][" << t.cols;
+	out << "] = {\n" << body.str() << "};\n\n";
+}
+
+//Emit a scalar constant
+void emitScalar(pugi::xml_node n, stringstream& out){
+	const char* type = scalarType(n.text().as_string());
+	string value = literal(n.text().as_string(), type);
+	//Keep integers for table size checks
+	long integer;
+	if(parseInteger(value, integer)) gIntegers[n.name()] = integer;
+	//Reloadable values are variables in HOT_RELOAD builds
+	if(isTunable(n.name())){
+		out << "#ifdef HOT_RELOAD\nextern " << type << " " << n.name() << ";\n#else\n"
+			<< "constexpr " << type << " " << n.name() << " = " << value << ";\n#endif\n";
+		gTunables.push_back(string("X(") + type + ", " + n.name() + ", " + value + ")");
+	}
+	else out << "constexpr " << type << " " << n.name() << " = " << value << ";\n";
+}
+
+//Emit a section of scalars and tables
+void emitSection(pugi::xml_node section, stringstream& out){
+	out << "///" << section.name() << "\n";
+	for(pugi::xml_node n = section.first_child(); n; n = n.next_sibling()){
+		const Table* t = findTable(n.name());
+		if(t){ out << "\n"; emitTable(*t, n, out); }
+		else emitScalar(n, out);
+	}
+	out << "\n";
+}
+
+//-----------------------------
+//------------MAIN-------------
+//-----------------------------
+
+int main(int argc, char* argv[]){
+	const char* input = argc > 1 ? argv[1] : "Constants.xml";
+	const char* output = argc > 2 ? argv[2] : "Constants.h";
+
+	//Load source file
+	pugi::xml_document doc;
+	pugi::xml_parse_result res = doc.load_file(input);
+	if(!res){
+		cerr << "constgen: " << input << ": " << res.description() << endl;
+		return 1;
+	}
+
+	//Header preamble
+	stringstream out;
+	out << "///Generated from " << input << " by constgen - do not edit\n\n"
+		<< "#ifndef CONSTANTS_H\n#define CONSTANTS_H\n\n"
+		<< "#include <utility>\nusing std::pair;\n\n";
+
+	//Emit sections and top level tables in file order
+	pugi::xml_node constants = doc.child("constants");
+	if(!constants) error("no <constants> root element");
+	for(pugi::xml_node n = constants.first_child(); n; n = n.next_sibling()){
+		const Table* t = findTable(n.name());
+		if(t){ out << "///" << n.name() << "\n"; emitTable(*t, n, out); }
+		else emitSection(n, out);
+	}
+
+	//Reloadable value list, expanded with X(type, name, default value)
+	out << "///Values reloadable at runtime\n#define TUNABLES(X)";
+	for(unsigned i = 0; i < gTunables.size(); ++i)
+		out << " \\\n\t" << gTunables[i];
+	out << "\n\n#endif\n";
+
+	//Do not write a broken header
+	if(gErrors){
+		cerr << "constgen: " << gErrors << " error(s), " << output << " not written" << endl;
+		return 1;
+	}
+
+	//Keep the old header (and its timestamp) if nothing changed
+	ifstream old(output);
+	stringstream current;
+	current << old.rdbuf();
+	if(old && current.str()==out.str()) return 0;
+	old.close();
+
+	ofstream file(output);
+	file << out.str();
+	if(!file){
+		cerr << "constgen: cannot write " << output << endl;
+		return 1;
+	}
+	cout << "constgen: " << input << " -> " << output << endl;
+	return 0;
+}
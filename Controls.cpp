@@ -24,6 +24,11 @@ void Controls::init(){
 	mSoundButton.setLocation(WIDTH-BUTTON_WIDTH-20, VERT_OFFSET/2);
 	mRulesButton.setLocation(WIDTH-BUTTON_WIDTH-20, VERT_OFFSET/2+3*BUTTON_HEIGHT/2);
 	mQuitButton.setLocation(WIDTH-BUTTON_WIDTH-20, VERT_OFFSET/2+2*VERT_OFFSET);
+
+	//Register buttons for hit testing
+	UI::addButton(mSoundButton, CONTROLS_SOUND);
+	UI::addButton(mRulesButton, CONTROLS_RULES);
+	UI::addButton(mQuitButton, CONTROLS_QUIT);
 }
 
 //Event handler
@@ -33,19 +38,13 @@ int Controls::eventHandler(SDL_Event & e){
 	
 	//Debounce events
 	if(UI::debounce()){
-		//Get sound button state
-		buttonState|=mSoundButton.isClicked(e);		
+		//Get clicked button state
+		buttonState = UI::clicked(e);
 		//Set correct button texture
-		if(Sound::mute) mSoundButton.setTexture(SOUND_OFF_PATH);
-		else mSoundButton.setTexture(SOUND_ON_PATH);
-		//Shift state holder bits
-		buttonState<<=1;
-		//Get rules button state
-		buttonState|=mRulesButton.isClicked(e);
-		//Shift state holder bits
-		buttonState<<=1;
-		//Get quit button state
-		buttonState|=mQuitButton.isClicked(e);
+		if(buttonState & CONTROLS_SOUND){
+			if(Sound::mute) mSoundButton.setTexture(SOUND_OFF_PATH);
+			else mSoundButton.setTexture(SOUND_ON_PATH);
+		}
 	}
 	//Return button states
 	return buttonState;
@@ -36,8 +36,7 @@ int Dice::getDiceResult() const {
 bool Dice::Event(SDL_Event& e){
 	if (e.type == SDL_MOUSEBUTTONDOWN) {
 		if( e.button.button == SDL_BUTTON_LEFT){
-			int x,y;
-			SDL_GetMouseState(&x,&y);
+			int x = e.button.x, y = e.button.y;
 			if(x>=posX && x<=posX+DICE_WIDTH &&
 				y>=posY && y<=posY+DICE_HEIGHT){
 					Dice::roll();
@@ -46,7 +45,7 @@ bool Dice::Event(SDL_Event& e){
 		}
 	}
 	//if space is pressed
-	if(e.key.keysym.sym == SDLK_SPACE)
+	if(e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_SPACE)
 		return 1;
 	return 0;
 }
@@ -0,0 +1,279 @@
+#include "Engine.h"
+
+#include <algorithm>
+using std::find;
+using std::shuffle;
+using std::rotate;
+
+//Constructor
+Engine::Engine(){
+	miTurn = 0;
+	miRoll = 0;
+}
+
+
+
+
+//Start a new game with a shuffled turn order
+void Engine::newGame(unsigned seed){
+	mRandom.seed(seed);
+	vector<Colors> order = {RED, BLUE, YELLOW};
+	shuffle(order.begin(), order.end(), mRandom);
+	newGame(order);
+}
+
+//Start a new game with a known turn order
+void Engine::newGame(const vector<Colors>& order){
+	mPlayers.clear();
+	miTurn = 0;
+	miRoll = 0;
+	for(unsigned i = 0; i < order.size(); ++i){
+		PlayerRecord p = {order[i], 0, 0, 0, 0, 0, 0, vector<PawnRecord>()};
+		//All pawns wait in base
+		for(int j = 0; j < PAWNS; ++j){
+			PawnRecord pawn = {0, BASE_SQUARES[order[i]-1][j].first, BASE_SQUARES[order[i]-1][j].second};
+			p.pawns.push_back(pawn);
+		}
+		mPlayers.push_back(p);
+		//Add a starting pawn
+		activate(mPlayers.back(), mPlayers.back().pawns[0]);
+	}
+}
+
+//Load a saved game
+void Engine::load(const vector<PlayerRecord>& players, int turn, int roll){
+	mPlayers = players;
+	miTurn = turn;
+	miRoll = roll;
+}
+
+
+
+
+//Roll the dice
+int Engine::roll(){
+	setRoll(std::uniform_int_distribution<int>(1, 6)(mRandom));
+	return miRoll;
+}
+
+//Set the roll of the current player
+void Engine::setRoll(int value){
+	miRoll = value;
+	if(!mPlayers.empty()) mPlayers.front().diceRoll = value;
+}
+
+
+
+
+//Legal moves of the current player
+vector<int> Engine::getMoves() const {
+	vector<int> moves;
+	if(!miRoll || mPlayers.empty() || isOver()) return moves;
+	const PlayerRecord& p = mPlayers.front();
+	//A 6 brings the first pawn in base into play
+	if(miRoll==6){
+		for(unsigned i = 0; i < p.pawns.size(); ++i){
+			if(isBase(p.pawns[i], p.color)){
+				moves.push_back(i);
+				break;
+			}
+		}
+	}
+	//Pawns on the board that do not overshoot
+	for(unsigned i = 0; i < p.pawns.size(); ++i)
+		if(isMoveable(p.pawns[i]) && isValid(p, p.pawns[i])) moves.push_back(i);
+	return moves;
+}
+
+//Apply a move
+bool Engine::move(int pawn){
+	//Check move
+	if(!miRoll || mPlayers.empty() || isOver()) return 0;
+	vector<int> moves = getMoves();
+	if(pawn==PASS ? !moves.empty() : find(moves.begin(), moves.end(), pawn)==moves.end()) return 0;
+
+	if(pawn!=PASS){
+		PlayerRecord& p = mPlayers.front();
+		PawnRecord& moving = p.pawns[pawn];
+		Colors c = p.color;
+		//If pawn is in base
+		if(isBase(moving, c)) activate(p, moving);
+		//If pawn is on the board
+		else {
+			int x = moving.x, y = moving.y, steps = 0;
+			bool finished = 0;
+			while(steps < miRoll && !finished){
+				//Safe zone directions start at the entry square
+				bool useSafe = (x==ENTRY_SQUARES[c-1].first && y==ENTRY_SQUARES[c-1].second);
+				pair<int,int> next = useSafe ? NEXT_SAFE[c-1] : NEXT_SQUARE[y][x];
+				x += next.first;
+				y += next.second;
+				steps++;
+				finished = (x==FINAL_SQUARES[c-1].first && y==FINAL_SQUARES[c-1].second);
+			}
+			//Take pawns on the destination square
+			if(!finished) capture(x, y, p);
+			else p.active--;
+			//Set pawn position (finished pawns keep their final slot in the position)
+			moving.x = x;
+			moving.y = y;
+			moving.position += miRoll;
+			p.steps += steps;
+		}
+	}
+
+	endTurn();
+	return 1;
+}
+
+
+
+
+//Players in turn order
+const vector<PlayerRecord>& Engine::getPlayers() const {
+	return mPlayers;
+}
+
+//Current player
+Colors Engine::getCurrent() const {
+	return mPlayers.empty() ? NONE : mPlayers.front().color;
+}
+
+//Roll of the current player
+int Engine::getRoll() const {
+	return miRoll;
+}
+
+//Finished turns
+int Engine::getTurn() const {
+	return miTurn;
+}
+
+//Check for game end
+bool Engine::isOver() const {
+	int finishedPlayers = 0;
+	for(unsigned i = 0; i < mPlayers.size(); ++i)
+		if(mPlayers[i].finished) finishedPlayers++;
+	return !mPlayers.empty() && finishedPlayers>=(PLAYERS-1);
+}
+
+//FNV-1a over every field
+static void mix(unsigned& hash, int value){
+	for(int i = 0; i < 4; ++i){
+		hash ^= (value>>(i*8)) & 0xff;
+		hash *= 16777619u;
+	}
+}
+
+//State hash
+unsigned Engine::getHash() const {
+	unsigned hash = 2166136261u;
+	mix(hash, miTurn);
+	mix(hash, miRoll);
+	for(unsigned i = 0; i < mPlayers.size(); ++i){
+		const PlayerRecord& p = mPlayers[i];
+		mix(hash, p.color);
+		mix(hash, p.steps);
+		mix(hash, p.taken);
+		mix(hash, p.lost);
+		mix(hash, p.active);
+		mix(hash, p.finished);
+		mix(hash, p.diceRoll);
+		for(unsigned j = 0; j < p.pawns.size(); ++j){
+			mix(hash, p.pawns[j].position);
+			mix(hash, p.pawns[j].x);
+			mix(hash, p.pawns[j].y);
+		}
+	}
+	return hash;
+}
+
+
+
+
+//Activate pawn
+void Engine::activate(PlayerRecord& p, PawnRecord& pawn){
+	pair<int,int> start = START_SQUARES[p.color-1];
+	capture(start.first, start.second, p);
+	pawn.x = start.first;
+	pawn.y = start.second;
+	pawn.position = 1;
+	p.active++;
+}
+
+//Send other pawns on a square back to base
+void Engine::capture(int x, int y, PlayerRecord& by){
+	for(unsigned i = 0; i < mPlayers.size(); ++i){
+		PlayerRecord& owner = mPlayers[i];
+		if(owner.color==by.color) continue;
+		for(unsigned j = 0; j < owner.pawns.size(); ++j){
+			PawnRecord& pawn = owner.pawns[j];
+			if(pawn.x!=x || pawn.y!=y || !isMoveable(pawn)) continue;
+			//Find free base square
+			pair<int,int> base;
+			for(int k = 0; k < PAWNS; ++k){
+				base = BASE_SQUARES[owner.color-1][k];
+				bool taken = 0;
+				for(unsigned l = 0; l < owner.pawns.size(); ++l)
+					if(owner.pawns[l].x==base.first && owner.pawns[l].y==base.second) taken = 1;
+				if(!taken) break;
+			}
+			pawn.x = base.first;
+			pawn.y = base.second;
+			pawn.position = 0;
+			owner.lost++;
+			owner.active--;
+			by.taken++;
+		}
+	}
+}
+
+//Check if pawn move is valid
+bool Engine::isValid(const PlayerRecord& p, const PawnRecord& pawn) const {
+	int to = pawn.position+miRoll;
+	//If roll is out of bounds
+	if(to>(BOARD_LENGTH+10)) return 0;
+	//If final position is occupied
+	if(to>(BOARD_LENGTH+5))
+		for(unsigned i = 0; i < p.pawns.size(); ++i)
+			if(p.pawns[i].position==to) return 0;
+	return 1;
+}
+
+//Determine if pawn is in base
+bool Engine::isBase(const PawnRecord& pawn, Colors c) const {
+	for(int i = 0; i < PAWNS; ++i)
+		if(pawn.x==BASE_SQUARES[c-1][i].first && pawn.y==BASE_SQUARES[c-1][i].second)
+			return 1;
+	return 0;
+}
+
+//Determine if pawn is on the board
+bool Engine::isMoveable(const PawnRecord& pawn) const {
+	return MOVEABLE_SQUARES[pawn.y][pawn.x];
+}
+
+
+
+
+//Finish turn
+void Engine::endTurn(){
+	PlayerRecord& p = mPlayers.front();
+	//If player has finished
+	bool finished = 1;
+	for(unsigned i = 0; i < p.pawns.size(); ++i)
+		if(p.pawns[i].position<=(BOARD_LENGTH+5)) finished = 0;
+	if(finished){
+		//Determine finish position
+		p.finished = 1;
+		for(unsigned i = 1; i < mPlayers.size(); ++i)
+			if(mPlayers[i].finished) p.finished++;
+	}
+	//If roll is a 6 get another turn
+	if(finished || miRoll!=6) rotate(mPlayers.begin(), mPlayers.begin()+1, mPlayers.end());
+	//Skip finished players
+	while(!isOver() && mPlayers.front().finished)
+		rotate(mPlayers.begin(), mPlayers.begin()+1, mPlayers.end());
+	miTurn++;
+	miRoll = 0;
+}
@@ -0,0 +1,105 @@
+///Headless game rules (no SDL, used by the server and online clients)
+
+#ifndef ENGINE_H
+#define ENGINE_H
+
+///Include local modules
+#include "Records.h"
+#include "Constants.h"
+
+///Misc library inclusion
+#include <random>
+#include <vector>
+using std::vector;
+
+///State of one match, kept in the Recovery data model
+///(players are stored in turn order, current player first)
+class Engine{
+public:
+
+	///Constructor (empty match)
+	Engine();
+
+	///Start a new game (shuffled turn order, one active pawn each)
+	///Args:
+	///unsigned seed - RNG seed of the match
+	void newGame(unsigned seed);
+
+	///Start a new game with a known turn order
+	///Args:
+	///const vector<Colors>& order - player colors in turn order
+	void newGame(const vector<Colors>& order);
+
+	///Load a saved game
+	///Args:
+	///const vector<PlayerRecord>& players - players in turn order
+	///int turn - finished turns
+	///int roll - roll of the current player (0 if not rolled)
+	void load(const vector<PlayerRecord>& players, int turn = 0, int roll = 0);
+
+	///Roll the dice for the current player (returns 1-6)
+	int roll();
+
+	///Set the roll of the current player (rolled elsewhere)
+	///Args:
+	///int value - dice result
+	void setRoll(int value);
+
+	///Pawns the current player can move with the roll
+	///(a roll of 6 offers the first pawn in base, empty if the turn passes)
+	vector<int> getMoves() const;
+
+	///Apply the move of the current player (returns 0 if the move is not legal)
+	///Args:
+	///int pawn - index of the pawn, PASS if there are no legal moves
+	bool move(int pawn);
+
+	///Players in turn order (current player first)
+	const vector<PlayerRecord>& getPlayers() const;
+
+	///Getters
+	Colors getCurrent() const;
+	int getRoll() const;
+	int getTurn() const;
+
+	///Check if all but one player have finished
+	bool isOver() const;
+
+	///Hash of the whole state (equal states give equal hashes on every platform)
+	unsigned getHash() const;
+
+private:
+
+	///Place a pawn from base on the start square
+	void activate(PlayerRecord& p, PawnRecord& pawn);
+
+	///Send pawns of other players on a square back to base
+	///Args:
+	///int x, y - board square
+	///PlayerRecord& by - moving player
+	void capture(int x, int y, PlayerRecord& by);
+
+	///Check if a pawn can move with the roll
+	bool isValid(const PlayerRecord& p, const PawnRecord& pawn) const;
+
+	///Square checks
+	bool isBase(const PawnRecord& pawn, Colors c) const;
+	bool isMoveable(const PawnRecord& pawn) const;
+
+	///Finish the turn of the current player
+	void endTurn();
+
+	///Players in turn order
+	vector<PlayerRecord> mPlayers;
+
+	///Finished turns
+	int miTurn;
+
+	///Roll of the current player (0 if not rolled)
+	int miRoll;
+
+	///Match RNG (small state, independent of rand())
+	std::minstd_rand mRandom;
+};
+
+#endif
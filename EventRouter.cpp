@@ -0,0 +1,46 @@
+#include "EventRouter.h"
+
+//Constructor
+EventRouter::EventRouter(){
+}
+
+//Screen handler registration
+void EventRouter::on(Screens screen, EventSlots slot, Handler h){
+	mHandlers[screen][slot].push_back(h);
+}
+
+//Key handler registration
+void EventRouter::onKey(SDL_Keycode key, Handler h){
+	mKeys[key] = h;
+}
+
+//Event routing
+void EventRouter::dispatch(SDL_Event& e, Screens screen, bool screenHandlers){
+	//Find event slot
+	EventSlots slot = getSlot(e.type);
+	if(slot==EVENT_SLOTS) return;
+
+	//Global keys
+	if(slot==KEY_DOWN){
+		map<SDL_Keycode, Handler>::iterator key = mKeys.find(e.key.keysym.sym);
+		if(key!=mKeys.end()) key->second(e);
+	}
+
+	//Screen handlers
+	if(!screenHandlers) return;
+	vector<Handler>& handlers = mHandlers[screen][slot];
+	for(unsigned i = 0; i < handlers.size(); ++i)
+		handlers[i](e);
+}
+
+//Event type to slot
+EventSlots EventRouter::getSlot(Uint32 type){
+	switch(type){
+		case SDL_KEYDOWN: return KEY_DOWN;
+		case SDL_KEYUP: return KEY_UP;
+		case SDL_MOUSEBUTTONDOWN: return MOUSE_DOWN;
+		case SDL_MOUSEBUTTONUP: return MOUSE_UP;
+		case SDL_MOUSEMOTION: return MOUSE_MOTION;
+		default: return EVENT_SLOTS;
+	}
+}
@@ -0,0 +1,65 @@
+///Event routing class
+
+#ifndef EVENTROUTER_H
+#define EVENTROUTER_H
+
+///Include local modules
+#include "Shared.h"
+
+///Misc library inclusion
+#include <functional>
+using std::function;
+#include <vector>
+using std::vector;
+#include <map>
+using std::map;
+
+///Routed event types
+enum EventSlots{
+	KEY_DOWN=0, KEY_UP, MOUSE_DOWN, MOUSE_UP, MOUSE_MOTION, EVENT_SLOTS
+};
+
+class EventRouter{
+public:
+
+	///Event handler type
+	typedef function<void(SDL_Event&)> Handler;
+
+	///Constructor
+	EventRouter();
+
+	///Register handler for a screen
+	///Args:
+	///Screens screen - screen the handler is active on
+	///EventSlots slot - event type
+	///Handler h - handler function
+	void on(Screens screen, EventSlots slot, Handler h);
+
+	///Register key handler active on every screen
+	///Args:
+	///SDL_Keycode key - key to handle
+	///Handler h - handler function
+	void onKey(SDL_Keycode key, Handler h);
+
+	///Route event to its handlers
+	///Args:
+	///SDL_Event& e - reference to SDL event container
+	///Screens screen - current screen
+	///bool screenHandlers - route to screen handlers (not required)
+	void dispatch(SDL_Event& e, Screens screen, bool screenHandlers = 1);
+
+	///Get slot for SDL event type (EVENT_SLOTS if not routed)
+	///Args:
+	///Uint32 type - SDL event type
+	static EventSlots getSlot(Uint32 type);
+
+private:
+
+	///Screen handlers
+	vector<Handler> mHandlers[SCREENS_NUM][EVENT_SLOTS];
+
+	///Global key handlers
+	map<SDL_Keycode, Handler> mKeys;
+};
+
+#endif
@@ -5,14 +5,34 @@ Game::Game()
 :mExplosion(SDL_Rect {0,0,EXPLODE_WIDTH,EXPLODE_HEIGHT},EXPLODE_FRAMES,EXPLODE_DELAY),
 mShockwave(SDL_Rect {0,0,SHOCK_WIDTH,SHOCK_HEIGHT},SHOCK_FRAMES,SHOCK_DELAY){
 	//Initialize class fields
-	miDiceTimer = SDL_GetTicks();
+	miDiceTimer = Clock::now();
 	mbRunning = 0;
 	mbHighlight = 0;
 	mbIgnoreRecovery = 0;
 	miCameraX = 0;
 	miCameraY = 0;
+	mfFromX = 0;
+	mfFromY = 0;
+	miTransitionStart = 0;
 	mbTransition = 0;
 	meScreen = BLANK;
+	mActiveUI = NULL;
+	mHighlightChoice = {-1,-1};
+	mbOnline = 0;
+	mbLockstep = 0;
+	meSeat = NONE;
+	miNetRoll = 0;
+	miNetMove = NET_WAIT;
+	mbNetRolled = 0;
+	mbNetMoved = 0;
+	mbNetResync = 0;
+	miNetSeq = 0;
+	for(int i = 0; i < BOARD_HEIGHT; ++i)
+		for(int j = 0; j < BOARD_WIDTH; ++j)
+			mbHighlighted[i][j] = 0;
+#ifdef HOT_RELOAD
+	miReloadGeneration = 0;
+#endif
 }
 
 
@@ -20,19 +40,36 @@ mShockwave(SDL_Rect {0,0,SHOCK_WIDTH,SHOCK_HEIGHT},SHOCK_FRAMES,SHOCK_DELAY){
 
 //Game loop
 void Game::loop(){
-					
-    //Handle events
-	eventHandler();
+	TRACE_SCOPE("Game::loop");
+
+#ifdef HOT_RELOAD
+	//Apply reloaded FX timings
+	if(miReloadGeneration!=HotReload::generation){
+		miReloadGeneration = HotReload::generation;
+		mExplosion.setNumOfFrames(EXPLODE_FRAMES);
+		mExplosion.setAnimationDelay(EXPLODE_DELAY);
+		mShockwave.setNumOfFrames(SHOCK_FRAMES);
+		mShockwave.setAnimationDelay(SHOCK_DELAY);
+	}
+#endif
+
+	//Finish expired FX tracks
+	mTimeline.update();
+
+	//Read server messages
+	pollNet();
 
 	//Render objects
 	render();
 
 	//If transitioning
-	if(mbTransition) transition();	
-	//If game is running
-	else if(mbRunning){	
+	if(mbTransition) updateTransition();	
+	//If game is running and no FX is awaited
+	else if(mbRunning && !mTimeline.isBlocking()){	
 		//Execute player turn
+		Profiler::begin(PHASE_TURN);
 		turn(mTurnOrder.front());
+		Profiler::end(PHASE_TURN);
 	
 		//Check for game end
 		int finishedPlayers = 0;
@@ -68,26 +105,41 @@ void Game::init(){
 #ifdef DEBUG
 	cout << "Game Init called" << endl;
 #endif
+	Resources::Scope scope("game");
     //Load game font
     mFont = TTF_OpenFont(FONT_PATH, FONT_SIZE);
     if(mFont==NULL) cerr << "Font error: " << TTF_GetError() << endl;
+    else Resources::add(mFont, RESOURCE_FONT, FONT_PATH, Resources::fileBytes(FONT_PATH));
 
 
 	//Load game board texture
 	mBoard.load(SCROLLABLE_PATH);
 
+	//Load pawn sheet and FX once (restarts reuse them)
+	Pawn::loadSheet();
+	{
+		Resources::Scope fx("fx");
+		mExplosion.load(EXPLODE_PATH);
+		mShockwave.load(SHOCK_PATH);
+	}
+
 	//Initialize highlighters
-	for(int i = 0; i < BOARD_HEIGHT; ++i)
-		for(int j = 0; j < BOARD_WIDTH; ++j)
-		mBoardHighlghters[i][j].setTexture(HIGHLIGHTER_PATH);
+	{
+		Resources::Scope highlighters("highlighters");
+		for(int i = 0; i < BOARD_HEIGHT; ++i)
+			for(int j = 0; j < BOARD_WIDTH; ++j)
+			mBoardHighlghters[i][j].setTexture(HIGHLIGHTER_PATH);
+	}
 
 	//Initialize dice
 	for(int i = 0; i < PLAYERS; ++i){
+		Resources::Scope dice("dice");
 		mDice.push_back(new Dice);
 		mDice.back()->setPosition(DICE_POS[i].first, DICE_POS[i].second);
 	}
 
     //Initialize UI
+	Resources::Scope ui("ui");
     mTitleScreen.init();
     mWinScreen.setFont(mFont);
     mWinScreen.init();
@@ -95,9 +147,18 @@ void Game::init(){
 	mControls.init();
 	mVolume.init();
 
-	//Draw continue on title screen if recovery is available	
-	mbIgnoreRecovery = !(Recovery::ReadFromXML().size()>0);
-	mTitleScreen.setContinue(!mbIgnoreRecovery);
+	//Register event handlers
+	initRouter();
+
+	//Probe recovery file (parsed state is kept for initGame)
+	RecoverySummary saved = Recovery::Probe();
+	mbIgnoreRecovery = !saved.valid;
+
+	//Draw continue on title screen if recovery is available
+	stringstream summary;
+	if(saved.valid) summary << "Turn " << saved.turn << ", " << saved.players << " players";
+	mTitleScreen.setFont(mFont);
+	mTitleScreen.setContinue(!mbIgnoreRecovery, summary.str());
 
 	//Set current screen
 	transition(TITLE);
@@ -113,6 +174,9 @@ void Game::initGame(){
 	cout << "initGame called" << endl;
 #endif
 
+	//Drop FX of the previous game
+	mTimeline.clear();
+
 	//Clear old board data
 	for(int i = 0; i < BOARD_HEIGHT; ++i){
 		for(int j = 0; j < BOARD_WIDTH; ++j){
@@ -125,18 +189,21 @@ void Game::initGame(){
     //Initialize final vectors with pawn placeholders
 	for(int i = 0; i < PLAYERS; ++i){
 		for(int j = 0; j < PAWNS; ++j){
-			mBoardVector[FINAL_SQUARES[i].first][FINAL_SQUARES[i].second].push_back(new Pawn(NONE));		
+			mPlaceholders[i][j].reset(NONE);
+			mBoardVector[FINAL_SQUARES[i].first][FINAL_SQUARES[i].second].push_back(&mPlaceholders[i][j]);
 		}
 	}	
 
 	if(mbIgnoreRecovery){
 	   cout << "Starting new game" << endl;
+	   //Drop saved state kept from the title screen probe
+	   Recovery::Discard();
    	   determineTurnOrder();
 	} else {
 		cout << "Recovering state" << endl;
 
-	//Try to recover state from XML	
-	mTurnOrder = Recovery::ReadFromXML();
+	//Recover state parsed by the title screen probe
+	Recovery::ReadFromXML(mPlayers, mTurnOrder);
 
 	//Set player data
 		for(unsigned i = 0; i < mTurnOrder.size(); ++i){
@@ -144,9 +211,7 @@ void Game::initGame(){
 				//If current pawn has finished
 				if(mTurnOrder[i]->m_vPawns[j]->getIPosition()>(BOARD_LENGTH+5)){
 					cout << (mTurnOrder[i]->m_vPawns[j]->getIPosition()-(BOARD_LENGTH+5)-1) << endl;
-					//Delete pawn placeholder
-					delete mBoardVector[mTurnOrder[i]->m_vPawns[j]->getIXPosition()][mTurnOrder[i]->m_vPawns[j]->getIYPosition()][mTurnOrder[i]->m_vPawns[j]->getIPosition()-(BOARD_LENGTH+5)-1];
-					//Place new pawn
+					//Place new pawn over the placeholder
 					mBoardVector[mTurnOrder[i]->m_vPawns[j]->getIXPosition()][mTurnOrder[i]->m_vPawns[j]->getIYPosition()][mTurnOrder[i]->m_vPawns[j]->getIPosition()-(BOARD_LENGTH+5)-1] = mTurnOrder[i]->m_vPawns[j];
 				} 
 				//If current pawn is on the active field
@@ -165,10 +230,6 @@ void Game::initGame(){
 	
 	//Play BGM
 	Sound::music(BGM);
-
-	//Load SFX
-	mExplosion.load(EXPLODE_PATH);
-	mShockwave.load(SHOCK_PATH);
 }
 
 
@@ -177,119 +238,178 @@ void Game::initGame(){
 
 
 //Event handler
-void Game::eventHandler(){	
+void Game::eventHandler(){
+	//UI handlers wait until the camera has reached the screen
+	mRouter.dispatch(mEvent, meScreen, !mbTransition);
+}
+
+
+
+
+
+//Event handler registration
+void Game::initRouter(){
+#ifdef DEBUG
+	//Set dice result
+	for(int i = 1; i <= 6; ++i)
+		mRouter.onKey(SDLK_0+i, [this, i](SDL_Event&){
+			if(mTurnOrder.empty() || mbOnline) return;
+			mbRoll = 0;
+			mDice[mTurnOrder.front()->getEColor()-1]->setDiceResult(i);
+		});
+
+	//Jump to screen
+	mRouter.onKey(SDLK_q, [this](SDL_Event&){ transition(RULES2,1); });
+	mRouter.onKey(SDLK_w, [this](SDL_Event&){ transition(RULES1,1); });
+	mRouter.onKey(SDLK_e, [this](SDL_Event&){ transition(TITLE,1); });
+	mRouter.onKey(SDLK_r, [this](SDL_Event&){ transition(GAME,1); });
+	mRouter.onKey(SDLK_t, [this](SDL_Event&){ transition(WIN,1); });
 
 	//Keyboard scroll
-	if(mEvent.key.keysym.sym == SDLK_1){ mbRoll=0; mDice[mTurnOrder.front()->getEColor()-1]->setDiceResult(1); };
-	if(mEvent.key.keysym.sym == SDLK_2){ mbRoll=0; mDice[mTurnOrder.front()->getEColor()-1]->setDiceResult(2); };
-	if(mEvent.key.keysym.sym == SDLK_3){ mbRoll=0; mDice[mTurnOrder.front()->getEColor()-1]->setDiceResult(3); };
-	if(mEvent.key.keysym.sym == SDLK_4){ mbRoll=0; mDice[mTurnOrder.front()->getEColor()-1]->setDiceResult(4); };
-	if(mEvent.key.keysym.sym == SDLK_5){ mbRoll=0; mDice[mTurnOrder.front()->getEColor()-1]->setDiceResult(5); };
-	if(mEvent.key.keysym.sym == SDLK_6){ mbRoll=0; mDice[mTurnOrder.front()->getEColor()-1]->setDiceResult(6); };
-	
-	if(mEvent.key.keysym.sym == SDLK_q) transition(RULES2,1);
-	if(mEvent.key.keysym.sym == SDLK_w) transition(RULES1,1);
-	if(mEvent.key.keysym.sym == SDLK_e) transition(TITLE,1);
-	if(mEvent.key.keysym.sym == SDLK_r) transition(GAME,1);
-	if(mEvent.key.keysym.sym == SDLK_t) transition(WIN,1);
-
-	if(mEvent.key.keysym.sym == SDLK_LEFT)miCameraX+=10;
-	if(mEvent.key.keysym.sym == SDLK_RIGHT)miCameraX-=10;
-	if(mEvent.key.keysym.sym == SDLK_UP)miCameraY+=10;
-	if(mEvent.key.keysym.sym == SDLK_DOWN)miCameraY-=10;
-	
-	//If no UI is active
-	if(!mActiveUI) return;
-	
-	//If on rules screen
-	if(dynamic_cast<Info*>(mActiveUI)){
-		//Get current button state
-		int rulesState = mActiveUI->eventHandler(mEvent);
-		//If back is clicked
-		if(rulesState&RULES_BACK) {
-			//If on first screen
-		   	if(meScreen == RULES1){	
+	mRouter.onKey(SDLK_LEFT, [this](SDL_Event&){ miCameraX+=10; });
+	mRouter.onKey(SDLK_RIGHT, [this](SDL_Event&){ miCameraX-=10; });
+	mRouter.onKey(SDLK_UP, [this](SDL_Event&){ miCameraY+=10; });
+	mRouter.onKey(SDLK_DOWN, [this](SDL_Event&){ miCameraY-=10; });
+#endif
+
+	//Profiler overlay
+	mRouter.onKey(SDLK_F3, [](SDL_Event&){ Profiler::toggle(); });
+	//Resource report
+	mRouter.onKey(SDLK_F5, [](SDL_Event&){ Resources::report(cout); });
+#ifdef TRACE
+	//Write trace file
+	mRouter.onKey(SDLK_F4, [](SDL_Event&){ Trace::dump(); });
+#endif
+
+	//Screen handlers
+	mRouter.on(RULES1, MOUSE_DOWN, [this](SDL_Event& e){ onRulesClick(e); });
+	mRouter.on(RULES2, MOUSE_DOWN, [this](SDL_Event& e){ onRulesClick(e); });
+	mRouter.on(TITLE, MOUSE_DOWN, [this](SDL_Event& e){ onTitleClick(e); });
+	mRouter.on(WIN, MOUSE_DOWN, [this](SDL_Event& e){ onWinClick(e); });
+	mRouter.on(GAME, MOUSE_DOWN, [this](SDL_Event& e){ onGameClick(e); });
+	mRouter.on(GAME, KEY_DOWN, [this](SDL_Event& e){ onDice(e); });
+}
+
+
+
+
+
+//Rules screen click handler
+void Game::onRulesClick(SDL_Event& e){
+	//Get current button state
+	int rulesState = mInfoScreen.eventHandler(e);
+	//If back is clicked
+	if(rulesState&RULES_BACK) {
+		//If on first screen
+		if(meScreen == RULES1){	
 			mbRunning = 1; transition(GAME);
-		   }
-			//If on second screen
-		   	else {
+		}
+		//If on second screen
+		else {
 			transition(RULES1);
-		   }
 		}
-		//If next is clicked
-		else if(rulesState&RULES_NEXT) {
-			//If on first screen
-		   	if(meScreen == RULES1){	
-				transition(RULES2);
-		   }
-			//If on second screen
-		   	else {
-			mbRunning = 1; transition(GAME);
-		   }
-		}		
 	}
-	
-	//If on title screen
-	else if(dynamic_cast<TitleScreen*>(mActiveUI)){
-		//Get current button states
-	     int titleState = mActiveUI->eventHandler(mEvent);
-	     //If start button is clicked
-	     if(titleState & TITLE_START){ transition(GAME); mbRoll = 1; mbRunning = 1; mbIgnoreRecovery = 1; initGame(); }
-	     //If continue button is clicked
-	     else if(titleState & TITLE_CONTINUE){ transition(GAME); mbRoll = 1; mbRunning = 1; initGame(); }
-	     //If quit button is clicked
-	     else if(titleState & TITLE_QUIT){ quit = 1;}
-	}
-	
-	//If on win screen
-	else if(dynamic_cast<WinScreen*>(mActiveUI)){
-		//Get current button states
-	     int winState = mActiveUI->eventHandler(mEvent);
-	     //If restart button is clicked
-	     if(winState & WIN_RESTART){ transition(GAME); mbRunning = 1; mbRoll = 1; mbIgnoreRecovery = 1; initGame(); }
-	     //If exit button is clicked
-	     else if(winState & WIN_QUIT){ quit = 1; }
+	//If next is clicked
+	else if(rulesState&RULES_NEXT) {
+		//If on first screen
+		if(meScreen == RULES1){	
+			transition(RULES2);
+		}
+		//If on second screen
+		else {
+			mbRunning = 1; transition(GAME);
+		}
 	}
-	
+}
+
+//Title screen click handler
+void Game::onTitleClick(SDL_Event& e){
+	//Get current button states
+	int titleState = mTitleScreen.eventHandler(e);
+	//Online matches start when the server starts them
+	if(mbOnline) titleState &= TITLE_QUIT;
+	//If start button is clicked
+	if(titleState & TITLE_START){ transition(GAME); mbRoll = 1; mbRunning = 1; mbIgnoreRecovery = 1; initGame(); }
+	//If continue button is clicked
+	else if(titleState & TITLE_CONTINUE){ transition(GAME); mbRoll = 1; mbRunning = 1; initGame(); }
+	//If quit button is clicked
+	else if(titleState & TITLE_QUIT){ quit = 1;}
+}
+
+//Win screen click handler
+void Game::onWinClick(SDL_Event& e){
+	//Get current button states
+	int winState = mWinScreen.eventHandler(e);
+	//If restart button is clicked
+	if(winState & WIN_RESTART){ transition(GAME); mbRunning = 1; mbRoll = 1; mbIgnoreRecovery = 1; initGame(); }
+	//If exit button is clicked
+	else if(winState & WIN_QUIT){ quit = 1; }
+}
+
+//Game screen click handler
+void Game::onGameClick(SDL_Event& e){
 	//If on volume screen
-	else if(dynamic_cast<Volume*>(mActiveUI)){
-	     mActiveUI->eventHandler(mEvent);
-	}	
-	//If on game screen
-	else if(dynamic_cast<Controls*>(mActiveUI)){
-		//Get current button states
-		int controlsState = mControls.eventHandler(mEvent);
-		//If sound button is clicked
-		//if(controlsState & CONTROLS_SOUND){ Sound::mute=!Sound::mute; Sound::mute?Sound::pause():Sound::music(BGM);	}
-		if(controlsState & CONTROLS_SOUND){ mActiveUI = &mVolume;	}
-		//If rules button is clicked
-		else if(controlsState & CONTROLS_RULES){ transition(RULES1); mbRunning = 0; }
-		//If quit button is clicked
-		else if(controlsState & CONTROLS_QUIT) quit = 1;
-
-		//If dice is rolling
-		if(mbRoll){
-			//If player clicked the dice
-			if(mDice[mTurnOrder.front()->getEColor()-1]->Event(mEvent)){
-				//Clear roll flag
-				mbRoll = 0;
-				//Play SFX
-				if(mDice[mTurnOrder.front()->getEColor()-1]->getDiceResult()==6){
-				   	Sound::play(ON_SIX);
-					mbShockwave = 1;
-					mShockwaveCoords = DICE_POS[mTurnOrder.front()->getEColor()-1];
-					mShockwaveCoords.first-=(SHOCK_WIDTH-DICE_WIDTH)/2;
-					mShockwaveCoords.second-=(SHOCK_HEIGHT-DICE_HEIGHT)/2;
-					delay(SHOCK_FRAMES*SHOCK_DELAY);
-					mbShockwave = 0;
-					}
-				else {
-					Sound::play(ON_DICE);
-					delay(500);
-				}
-			}
+	if(mActiveUI==&mVolume){
+		mVolume.eventHandler(e);
+		return;
+	}
+
+	//Get current button states
+	int controlsState = mControls.eventHandler(e);
+	//If sound button is clicked
+	//if(controlsState & CONTROLS_SOUND){ Sound::mute=!Sound::mute; Sound::mute?Sound::pause():Sound::music(BGM);	}
+	if(controlsState & CONTROLS_SOUND){ mActiveUI = &mVolume; return; }
+	//If rules button is clicked
+	else if(controlsState & CONTROLS_RULES){ transition(RULES1); mbRunning = 0; return; }
+	//If quit button is clicked
+	else if(controlsState & CONTROLS_QUIT){ quit = 1; return; }
+
+	//Wait for running FX
+	if(mTimeline.isBlocking()) return;
+
+	//Dice click
+	onDice(e);
+
+	//Highlighted square click
+	if(mbHighlight) selectHighlighted(e);
+}
+
+//Dice event handler
+void Game::onDice(SDL_Event& e){
+	//If dice is rolling
+	if(!mbRoll || mTurnOrder.empty()) return;
+	//Online: the local player asks the server to roll (spectators have no seat)
+	if(mbOnline){
+		if(mTurnOrder.front()->getEColor()==meSeat && !mbNetRolled && mDice[meSeat-1]->Event(e)){
+			netSend(Message(MSG_ROLL_REQUEST));
+			mbNetRolled = 1;
 		}
+		return;
+	}
+	//If player clicked the dice
+	if(mDice[mTurnOrder.front()->getEColor()-1]->Event(e)) onRolled();
+}
 
+//Dice roll result
+void Game::onRolled(){
+	//Clear roll flag
+	mbRoll = 0;
+	//Play SFX
+	if(mDice[mTurnOrder.front()->getEColor()-1]->getDiceResult()==6){
+	   	Sound::play(ON_SIX);
+		//Shockwave around the dice
+		pair<int,int> coords = DICE_POS[mTurnOrder.front()->getEColor()-1];
+		coords.first-=(SHOCK_WIDTH-DICE_WIDTH)/2;
+		coords.second-=(SHOCK_HEIGHT-DICE_HEIGHT)/2;
+		Uint32 frameDelay = SHOCK_DELAY;
+		mTimeline.add(SHOCK_FRAMES*SHOCK_DELAY, 1, [this, coords, frameDelay](Uint32 t){
+			mShockwave.renderFrame(coords.first, coords.second, t/frameDelay);
+		}, UNDER_DICE);
+	}
+	else {
+		Sound::play(ON_DICE);
+		//Pause before the move
+		mTimeline.add(500, 1);
 	}
 }
 
@@ -301,23 +421,34 @@ void Game::eventHandler(){
 
 
 
+
 //Render all assets
 void Game::render(){
+	TRACE_SCOPE("Game::render");
 
 #ifdef DEBUG
 	//cout << "Render called" << endl;
 #endif
 
 	//Render background
+	Profiler::begin(PHASE_BACKGROUND);
 	renderBackground();
+	Profiler::end(PHASE_BACKGROUND);
 	
 	if(!mbTransition){
 		//Render sprites 
+		Profiler::begin(PHASE_SPRITES);
 		if(meScreen==GAME) renderSprite();
+		Profiler::end(PHASE_SPRITES);
 
 		//Render UI
+		Profiler::begin(PHASE_UI);
 		renderUI();
+		Profiler::end(PHASE_UI);
 	}
+
+	//Render profiler overlay
+	Profiler::render(mFont);
 }
 
 //Render background
@@ -357,23 +488,22 @@ void Game::renderSprite(){
         mTurnOrder[i]->Render(pos);
     }	
 	
-	//Render shockwave
-	if(mbShockwave)
-		mShockwave.render(mShockwaveCoords.first, mShockwaveCoords.second);
+	//Render FX under dice
+	mTimeline.render(UNDER_DICE);
 
 	//Render dice
 	for(unsigned i = 0; i < PLAYERS; ++i)
 		mDice[i]->render();
 	
-	//Render explosion
-	if(mbExplosion) 
-		mExplosion.render(mExplosionCoords.first, mExplosionCoords.second-50);		
+	//Render FX over dice
+	mTimeline.render(OVER_DICE);
 }
 
 //Render UI
 void Game::renderUI(){
 
-	//Render controls
+	//Render controls (win screen text is drawn here)
+	Resources::Scope scope("ui");
 	mActiveUI->render();
 }
 
@@ -381,11 +511,139 @@ void Game::renderUI(){
 
 
 
+//Render scripted scenes and report their speed
+bool Game::benchmark(int frames){
+	if(frames<=0) return 0;
+	cout << "Render benchmark (" << SDL_GetCurrentVideoDriver() << " video driver, "
+	     << frames << " frames per scene)" << endl;
+
+	//Board with every pawn in play (a new game starts with one pawn out, then every
+	//turn brings a pawn out with a 6 and moves it a square further than the last one)
+	Engine engine;
+	engine.newGame(1);
+	for(int i = 0; i < PLAYERS*(PAWNS-1); ++i){
+		engine.setRoll(6);
+		engine.move(engine.getMoves().front());
+		const PlayerRecord& p = engine.getPlayers().front();
+		engine.setRoll(p.active);
+		vector<int> moves = engine.getMoves();
+		if(moves.empty()) break;
+		int pick = moves.front();
+		for(unsigned j = 0; j < moves.size(); ++j)
+			if(p.pawns[moves[j]].position==1) pick = moves[j];
+		engine.move(pick);
+	}
+	Recovery::Load(engine.getPlayers(), engine.getTurn(), 1);
+
+	//Capture: the first move of a seeded game that takes a pawn with a pawn in play
+	//(pawns leaving base take through activatePawn)
+	Engine capture;
+	int capturePawn = -1;
+	capture.newGame(1);
+	while(capturePawn<0 && !capture.isOver()){
+		capture.roll();
+		vector<int> moves = capture.getMoves();
+		for(unsigned j = 0; j < moves.size() && capturePawn<0; ++j){
+			if(capture.getPlayers().front().pawns[moves[j]].position==0) continue;
+			Engine after = capture;
+			after.move(moves[j]);
+			for(unsigned k = 0; k < after.getPlayers().size(); ++k)
+				if(after.getPlayers()[k].color==capture.getCurrent() && after.getPlayers()[k].taken>capture.getPlayers().front().taken)
+					capturePawn = moves[j];
+		}
+		if(capturePawn<0) capture.move(moves.empty() ? PASS : moves.front());
+	}
+	//Load the position before the capture and make the move (game output muted)
+	auto takePawn = [this, &capture, capturePawn](){
+		std::streambuf* out = cout.rdbuf(NULL);
+		Recovery::Load(capture.getPlayers(), capture.getTurn(), 1);
+		mbIgnoreRecovery = 0;
+		initGame();
+		Sound::pause();
+		mbMove = 0;
+		miRemaining = 0;
+		movePawn(mTurnOrder.front()->m_vPawns[capturePawn], capture.getRoll());
+		cout.rdbuf(out);
+	};
+
+	//Scenes
+	const char* names[] = {"title", "board", "capture", "win"};
+	bool ok = 1;
+	for(int scene = 0; scene < 4; ++scene){
+		//Stage scene
+		if(scene==0) transition(TITLE, 1);
+		else if(scene==1){
+			mbIgnoreRecovery = 0;
+			initGame();
+			Sound::pause();
+			transition(GAME, 1);
+		} else if(scene==3){
+			mTimeline.clear();
+			for(unsigned i = 0; i < mTurnOrder.size(); ++i)
+				mTurnOrder[i]->setIFinishPosition(i+1);
+			transition(WIN, 1);
+		}
+
+		if(scene==2 && capturePawn<0){
+			cerr << "Render benchmark error: no capture found" << endl;
+			ok = 0;
+			continue;
+		}
+
+		//Render frames (a warm up pass first, the capture is made again when its explosion ends)
+		vector<double> times;
+		Uint64 frequency = SDL_GetPerformanceFrequency();
+		Uint64 start = 0;
+		clock_t cpu = 0;
+		for(int i = -BENCH_WARMUP; i < frames; ++i){
+			if(scene==2 && !mTimeline.isBlocking()){
+				takePawn();
+				//The collision starts the explosion
+				if(!mTimeline.isBlocking()){
+					cerr << "Render benchmark error: the capture move took no pawn" << endl;
+					ok = 0;
+					break;
+				}
+			}
+			if(i==0){
+				start = SDL_GetPerformanceCounter();
+				cpu = clock();
+			}
+			Uint64 frameStart = SDL_GetPerformanceCounter();
+			Clock::tick();
+			mTimeline.update();
+			render();
+			SDL_RenderPresent(Texture::mRenderer);
+			if(i>=0) times.push_back((double)(SDL_GetPerformanceCounter()-frameStart)*1000/frequency);
+		}
+		double wall = (double)(SDL_GetPerformanceCounter()-start)/frequency;
+		double cpuMs = (double)(clock()-cpu)*1000/CLOCKS_PER_SEC;
+		if(wall<=0 || (int)times.size()<frames){
+			ok = 0;
+			continue;
+		}
+
+		//Report
+		sort(times.begin(), times.end());
+		char line[120];
+		snprintf(line, sizeof(line), "%-8s %8.1f FPS  %7.3f ms CPU/frame  p50 %7.3f ms  p95 %7.3f ms", names[scene],
+		         frames/wall, cpuMs/frames, times[times.size()/2], times[times.size()*95/100]);
+		cout << line << endl;
+	}
+	mTimeline.clear();
+	return ok;
+}
+
+
+
+
+
 
 
 
 //Player turn
 void Game::turn(Player* p){
+	TRACE_SCOPE("Game::turn");
     
 #ifdef DEBUG
 	//cout << "Turn called with " << p->getEColor() << endl;
@@ -397,8 +655,12 @@ void Game::turn(Player* p){
 			//Roll the dice
 			diceRoll();
 		} else {
+			//If the move comes from the server
+			if(!mbMove && mbOnline){
+				if(!netMove(p)) return;
+			}
 			//If no pawn is moving
-			if(!mbMove){
+			else if(!mbMove){
 #ifdef DEBUG
 //	cout << "Player " << p->getEColor() << " rolled " << p->getIDiceRoll() << endl;
 #endif
@@ -496,9 +758,9 @@ void Game::turn(Player* p){
 			//If remaining moves are available
 			else {
 				//Delay
-				if(SDL_GetTicks()-miMoveDelay>MOVEMENT_DELAY){
+				if(Clock::now()-miMoveDelay>(Uint32)MOVEMENT_DELAY){
 					//Reset timer
-					miMoveDelay = SDL_GetTicks();	
+					miMoveDelay = Clock::now();	
 					//Decrease remaining move counter
 					miRemaining--;
 					//Move pawn
@@ -534,6 +796,10 @@ void Game::turn(Player* p){
 							mTurnOrder.pop_front();
 						}
 					}
+
+					//Count finished turn
+					Recovery::turnCount++;
+					Metrics::count(METRIC_TURNS);
 	
 					//Save recovery data
 					Recovery::WriteXML(mTurnOrder);	
@@ -573,20 +839,18 @@ void Game::determineTurnOrder(){
 #ifdef DEBUG
 	cout << "DetermineTurnOrder called" << endl;
 #endif
-	//Refresh RNG seed
-	srand(time(0));
+	//Reset turn counter
+	Recovery::turnCount = 0;
 	//Clear old data if existing
-	while(mTurnOrder.size()){
-		delete mTurnOrder.back();
-		mTurnOrder.pop_back();
-	}
-	//Temporary vector of colors to choose from
-	vector<Colors> order = {RED, BLUE, YELLOW};
-	//Shuffle vector
-	random_shuffle(order.begin(), order.end());
-	//Initialize player objects
+	mTurnOrder.clear();
+	//Colors to choose from
+	Colors order[PLAYERS] = {RED, BLUE, YELLOW};
+	//Shuffle colors
+	random_shuffle(order, order+PLAYERS);
+	//Reset player slots
 	for(int i = 0; i < PLAYERS; ++i){
-		mTurnOrder.push_back(new Player(order[i]));
+		mPlayers[i].reset(order[i]);
+		mTurnOrder.push_back(&mPlayers[i]);
 		//Add a starting pawn
 		activatePawn(mTurnOrder.back());
 	}
@@ -608,9 +872,9 @@ void Game::diceRoll(){
 
 		//Save current roll
 		mDice[mTurnOrder.front()->getEColor()-1]->roll();
-	if((SDL_GetTicks()-miDiceTimer)>500){
+	if((Clock::now()-miDiceTimer)>500){
 		//Reset timer
-		miDiceTimer = SDL_GetTicks();
+		miDiceTimer = Clock::now();
 		//Play SFX
 		Sound::play(ON_ROLL);
 	}
@@ -623,6 +887,7 @@ void Game::diceRoll(){
 
 //Pawn movement
 void Game::movePawn(Pawn* p, int with){
+	TRACE_SCOPE("Game::movePawn");
 #ifdef DEBUG
 	cout << "MovePawn called with " << p->getEColor() << " " << with << endl;
 #endif
@@ -675,11 +940,9 @@ void Game::movePawn(Pawn* p, int with){
 			return;
 		//If final space is unoccupied
 		else{
-			//Delete pawn placeholder
-			delete mBoardVector[FINAL_SQUARES[p->getEColor()-1].first][FINAL_SQUARES[p->getEColor()-1].second][miRemaining];
 			//Set pawn finish position
 			p->setIPosition(p->getIPosition()+miRemaining);
-			//Place pawn in final vector
+			//Place pawn in final vector (over the placeholder)
 			mBoardVector[FINAL_SQUARES[p->getEColor()-1].first][FINAL_SQUARES[p->getEColor()-1].second][miRemaining] = p;	
 			//Decrease player active counter
 			mTurnOrder.front()->setIActivePawns(mTurnOrder.front()->getIActivePawns()-1);
@@ -723,6 +986,7 @@ void Game::movePawn(Pawn* p, int with){
 
 //Collision detection
 void Game::collision(Pawn * p, int pX, int pY){
+	TRACE_SCOPE("Game::collision");
 #ifdef DEBUG
 	cout << "Collision called with " << p->getEColor() << " " << pX << " " << pY << endl;
 #endif
@@ -767,15 +1031,21 @@ void Game::collision(Pawn * p, int pX, int pY){
 #endif			
 			//Play SFX
 			Sound::play(ON_COLLISION);
-			//Explode
-			mbExplosion = 1;
-			mExplosionCoords = getCoords(pX, pY);
-			delay(EXPLODE_DELAY*EXPLODE_FRAMES);
-			mbExplosion = 0;
+			//Explode (next turn waits for it)
+			explode(pX, pY);
 		}
 	}
 }
 
+//Explosion FX
+void Game::explode(int pX, int pY){
+	pair<int,int> coords = getCoords(pX, pY);
+	Uint32 frameDelay = EXPLODE_DELAY;
+	mTimeline.add(EXPLODE_DELAY*EXPLODE_FRAMES, 1, [this, coords, frameDelay](Uint32 t){
+		mExplosion.renderFrame(coords.first, coords.second-50, t/frameDelay);
+	});
+}
+
 
 
 
@@ -797,6 +1067,7 @@ void Game::highlight(int pX, int pY){
 	
 	//Add to active highlighter list
 	mActiveHighlighters.push_back(pair<int,int> {pX, pY});
+	mbHighlighted[pX][pY] = 1;
 }
 
 
@@ -804,53 +1075,37 @@ void Game::highlight(int pX, int pY){
 
 
 //Highlighted squares event handler
-pair<int,int> Game::getHighlightedChoice(){
+void Game::selectHighlighted(SDL_Event& e){
 #ifdef DEBUG
-	cout << "GetHighlightedChoice called" << endl;
+	cout << "SelectHighlighted called" << endl;
 #endif
-	//Selected coordinate container
-	pair<int,int> choice = {-1,-1};
-
-
-	//If active highlighters exist
-	if(mActiveHighlighters.size()){
-		//Traverse active highlighters
-		for(unsigned i = 0; i < mActiveHighlighters.size(); ++i){
-			//If clicked
-			if(mBoardHighlghters[mActiveHighlighters[i].first][mActiveHighlighters[i].second].isClicked(mEvent)){
-				//Save board index before clearing
-				choice = mActiveHighlighters[i];
-				//Clear active highlighters
-				while(mActiveHighlighters.size()>0) mActiveHighlighters.pop_back();
-				//Play SFX
-				Sound::play(camera);
-				//Lower highlighter flag
-				mbHighlight = 0;
-				cout << "Selected: " << choice.first << " " << choice.second << endl;
-				//Return selected index
-				return choice;
-			}
+	if(e.type!=SDL_MOUSEBUTTONDOWN) return;
+	//Find square under the click (highlighters are drawn 5px left and 15px up)
+	pair<int,int> square = getSquare(e.button.x+5, e.button.y+15);
+	if(square.first<0 || !mbHighlighted[square.first][square.second]) return;
+	//If clicked
+	if(mBoardHighlghters[square.first][square.second].isClicked(e)){
+		//Save board index
+		mHighlightChoice = square;
+		//Clear active highlighters
+		while(mActiveHighlighters.size()>0){
+			mbHighlighted[mActiveHighlighters.back().first][mActiveHighlighters.back().second] = 0;
+			mActiveHighlighters.pop_back();
 		}
+		//Play SFX
+		Sound::play(camera);
+		//Lower highlighter flag
+		mbHighlight = 0;
+		cout << "Selected: " << mHighlightChoice.first << " " << mHighlightChoice.second << endl;
 	}
-	//Return invalid value if nothing is selected
-	return choice;
 }
 
-
-
-
-
-//Timed delay
-void Game::delay(Uint32 ms){
-#ifdef DEBUG
-	cout << "Delay called with " << ms << endl;
-#endif
-	Uint32 timerDelay = SDL_GetTicks();
-	while(SDL_GetTicks()-timerDelay<ms){
-		eventHandler();
-		render();
-		SDL_RenderPresent(Texture::mRenderer);
-	}
+//Picked highlighted square
+pair<int,int> Game::getHighlightedChoice(){
+	//Return and clear choice (invalid value if nothing is selected)
+	pair<int,int> choice = mHighlightChoice;
+	mHighlightChoice = {-1,-1};
+	return choice;
 }
 
 
@@ -887,6 +1142,271 @@ void Game::activatePawn(Player * p){
 
 
 
+//Join or watch online match
+bool Game::connect(const string& address, int match, bool watch){
+	if(!mNet.open(address)) return 0;
+	Message hello(MSG_HELLO);
+	hello.value = PROTOCOL_VERSION;
+	mNet.send(hello);
+	//Spectators get no seat, so every turn is played from server messages
+	Message join(watch ? MSG_WATCH : MSG_JOIN);
+	join.value = match;
+	mNet.send(join);
+	mbOnline = 1;
+	//Wait on the title screen until the match starts
+	mTitleScreen.setContinue(0, watch ? "Waiting for match..." : "Waiting for players...");
+	cout << (watch ? "Watching match " : "Joining match ") << match << " on " << address << endl;
+	return 1;
+}
+
+//Host or join lockstep match
+bool Game::lockstep(const string& address, bool host){
+	if(!(host ? mLockstep.host(address, 1) : mLockstep.join(address, 1))) return 0;
+	mbOnline = 1;
+	mbLockstep = 1;
+	//Wait on the title screen until all seats are taken
+	mTitleScreen.setContinue(0, "Waiting for peers...");
+	cout << (host ? "Hosting lockstep match on " : "Joining lockstep match on ") << address << endl;
+	return 1;
+}
+
+//Server message handler
+void Game::pollNet(){
+	//Peers produce the messages a server would send
+	if(mbLockstep) mLockstep.poll(mNetQueue);
+	//Read server messages
+	else if(mNet.isOpen()){
+		bool open = mNet.receive();
+		Message m;
+		int result;
+		while((result = mNet.next(m))>0) mNetQueue.push_back(m);
+		mNet.flush();
+		if(!open || result<0){
+			cerr << "Connection to server lost" << endl;
+			mNet.close();
+			mNetQueue.push_back(Message(MSG_LEFT));
+		}
+	}
+
+	//Apply messages in order while the game is ready for them
+	while(!mNetQueue.empty()){
+		const Message& m = mNetQueue.front();
+		//Deltas are dropped while a snapshot is awaited
+		if(m.seq && m.type!=MSG_SNAPSHOT && (mbNetResync || m.seq!=miNetSeq+1)){
+			if(!mbNetResync) netResync();
+			mNetQueue.pop_front();
+			continue;
+		}
+		switch(m.type){
+			//Seat taken
+			case MSG_SEAT:
+				meSeat = m.color;
+				break;
+			//Full state (match start or resync)
+			case MSG_SNAPSHOT:
+				netSnapshot(m);
+				break;
+			//Turn change (after the previous move has been animated)
+			case MSG_TURN:
+			case MSG_END:
+				if(miNetRoll || mbMove || mTimeline.isBlocking()) return;
+				//Local state must agree with the deltas of the last move
+				if(!netVerify(m.type==MSG_TURN ? m.color : NONE)){
+					netResync();
+					mNetQueue.pop_front();
+					continue;
+				}
+				//Match over
+				if(m.type==MSG_END){
+					netClose();
+					mbOnline = 0;
+				}
+				break;
+			//Dice result
+			case MSG_ROLL:
+				if(!mbRunning || !mbRoll || mTurnOrder.front()->getEColor()!=m.color) return;
+				mDice[m.color-1]->setDiceResult(m.value);
+				miNetRoll = m.value;
+				mbNetRolled = 0;
+				onRolled();
+				break;
+			//Pawn choice
+			case MSG_MOVE:
+				if(!miNetRoll || miNetMove!=NET_WAIT) return;
+				miNetMove = m.pawn;
+				mNetDeltas.push_back(m);
+				break;
+			//Pawn sent back to base
+			case MSG_CAPTURE:
+				mNetDeltas.push_back(m);
+				break;
+			//Player left or connection lost
+			case MSG_LEFT:
+				if(m.color) cerr << "Player " << m.color << " left the match" << endl;
+				netClose();
+				mbOnline = 0;
+				mbRunning = 0;
+				mNetQueue.clear();
+				transition(TITLE);
+				return;
+			//Refused command
+			case MSG_ERROR:
+				cerr << "Server refused command: error " << m.value << endl;
+				break;
+			default:
+				break;
+		}
+		if(m.seq) miNetSeq = m.seq;
+		mNetQueue.pop_front();
+	}
+}
+
+//Ask for a snapshot
+void Game::netResync(){
+#ifdef DEBUG
+	cout << "Out of sync after " << miNetSeq << ", requesting snapshot" << endl;
+#endif
+	Message resync(MSG_RESYNC);
+	resync.seq = miNetSeq;
+	netSend(resync);
+	mbNetResync = 1;
+}
+
+//Send command
+void Game::netSend(const Message& m){
+	if(mbLockstep) mLockstep.send(m);
+	else mNet.send(m);
+}
+
+//Close connection
+void Game::netClose(){
+	if(mbLockstep) mLockstep.close();
+	else mNet.close();
+}
+
+//Load full state
+void Game::netSnapshot(const Message& m){
+	//Drop players and highlights of the previous state
+	mTurnOrder.clear();
+	while(mActiveHighlighters.size()>0){
+		mbHighlighted[mActiveHighlighters.back().first][mActiveHighlighters.back().second] = 0;
+		mActiveHighlighters.pop_back();
+	}
+	mbHighlight = 0;
+	mbMove = 0;
+	miRemaining = 0;
+
+	//Start from the received state
+	Recovery::Load(m.players, m.turn, m.roll!=0);
+	mbIgnoreRecovery = 0;
+	if(!mbRunning){ transition(GAME); mbRunning = 1; }
+	initGame();
+	miNetSeq = m.seq;
+	miNetRoll = m.roll;
+	miNetMove = NET_WAIT;
+	mbNetRolled = 0;
+	mbNetMoved = 0;
+	mbNetResync = 0;
+	mNetDeltas.clear();
+}
+
+//Compare local state with received deltas
+bool Game::netVerify(Colors next){
+	vector<PlayerRecord> players = Recovery::ToRecords(mTurnOrder);
+	bool valid = 1;
+	for(unsigned i = 0; i < mNetDeltas.size(); ++i){
+		const Message& d = mNetDeltas[i];
+		if(d.pawn==PASS) continue;
+		for(unsigned j = 0; j < players.size(); ++j){
+			if(players[j].color!=d.color) continue;
+			const PawnRecord& pawn = players[j].pawns[d.pawn];
+			//Captured pawns may take another free base square
+			if(pawn.position!=d.state.position) valid = 0;
+			if(d.type==MSG_MOVE && (pawn.x!=d.state.x || pawn.y!=d.state.y)) valid = 0;
+		}
+	}
+	mNetDeltas.clear();
+	//Next player (finished players are still being skipped locally)
+	if(next){
+		unsigned i = 0;
+		while(i < players.size() && players[i].finished) i++;
+		if(i==players.size() || players[i].color!=next) valid = 0;
+	}
+	return valid;
+}
+
+//Apply server move
+bool Game::netMove(Player* p){
+	//Wait for the roll
+	if(!miNetRoll) return 0;
+	p->setIDiceRoll(miNetRoll);
+	//Wait for the move (the local player picks one first)
+	if(miNetMove==NET_WAIT){
+		if(p->getEColor()==meSeat) pickNetMove(p);
+		return 0;
+	}
+	int pawn = miNetMove;
+	miNetRoll = 0;
+	miNetMove = NET_WAIT;
+	mbNetMoved = 0;
+	//If turn passes
+	if(pawn==PASS) return 1;
+	Pawn* moving = p->m_vPawns[pawn];
+	//If pawn is in base
+	if(isBase(moving->getIXPosition(), moving->getIYPosition(), p->getEColor())) activatePawn(p);
+	//If pawn is on the board
+	else {
+		//Squares move their top pawn
+		vector<Pawn*>& square = mBoardVector[moving->getIXPosition()][moving->getIYPosition()];
+		iter_swap(find(square.begin(), square.end(), moving), square.end()-1);
+		//Raise movement flag
+		mbMove = 1;
+		//Assign moving pawn
+		mMovingPawn = moving;
+		//Set pawn as active
+		mMovingPawn->setBIdle(0);
+		//Assign remaining moves
+		miRemaining = p->getIDiceRoll();
+	}
+	return 1;
+}
+
+//Pick local move
+void Game::pickNetMove(Player* p){
+	//Wait for the server to confirm the sent move
+	if(mbNetMoved) return;
+	//Legal moves of the current state
+	Engine engine;
+	engine.load(Recovery::ToRecords(mTurnOrder), Recovery::turnCount, miNetRoll);
+	vector<int> moves = engine.getMoves();
+	//Turns without a choice are played by the server
+	if(moves.size()<=1) return;
+	//If highlighters have not been set this turn
+	if(!mbHighlight){
+		for(unsigned i = 0; i < moves.size(); ++i)
+			highlight(p->m_vPawns[moves[i]]->getIXPosition(), p->m_vPawns[moves[i]]->getIYPosition());
+		mbHighlight = 1;
+	}
+	//Get choice from highlights
+	pair<int,int> choice = getHighlightedChoice();
+	if(choice.first<0 || choice.second<0) return;
+	//Send the pawn on top of the chosen square
+	Pawn* picked = mBoardVector[choice.first][choice.second].back();
+	for(unsigned i = 0; i < moves.size(); ++i){
+		if(p->m_vPawns[moves[i]]==picked){
+			Message move(MSG_MOVE_REQUEST);
+			move.pawn = moves[i];
+			netSend(move);
+			mbNetMoved = 1;
+			return;
+		}
+	}
+}
+
+
+
+
+
 //Get world coordinates from array index
 pair<int,int> Game::getCoords(int pX, int pY){
     
@@ -898,6 +1418,15 @@ pair<int,int> Game::getCoords(int pX, int pY){
 	return pair<int,int> {pX*SQUARE_SIZE+X_OFF, pY*SQUARE_SIZE+Y_OFF};	
 }
 
+//Get board position from screen coordinates
+pair<int,int> Game::getSquare(int x, int y){
+	//Outside of the board
+	if(x<X_OFF || y<Y_OFF) return pair<int,int> {-1,-1};
+	int pX = (x-X_OFF)/SQUARE_SIZE, pY = (y-Y_OFF)/SQUARE_SIZE;
+	if(pX>=BOARD_WIDTH || pY>=BOARD_HEIGHT) return pair<int,int> {-1,-1};
+	return pair<int,int> {pX, pY};
+}
+
 //Get screen coordinates for final vector
 pair<int,int> Game::getFinalCoords(Colors c, int pos){ 
 #ifdef DEBUG
@@ -973,60 +1502,56 @@ bool Game::hasFinished(Player* p){
 
 
 
+//Camera easing curve
+static float ease(float t){
+	switch(TRANSITION_EASING){
+		//Ease in-out (cubic)
+		case 1: return t<0.5 ? 4*t*t*t : 1-pow(2-2*t,3)/2;
+		//Ease out (cubic)
+		case 2: return 1-pow(1-t,3);
+		//Linear
+		default: return t;
+	}
+}
+
 //Screen transition
 void Game::transition(Screens to, bool instant){
 #ifdef DEBUG
 	//cout << "Transition called with " << to << endl;
 #endif	
 
-	//If not transitioning
-	if(!mbTransition){
-		cout << "Camera: (" << miCameraX << ", " << miCameraY << ")" << endl;
-		//New coordinate holder
-		pair<int,int> coords = SCREEN_COORDS[to];
-		cout << "Destination: (" << coords.first << ", " << coords.second << ")" << endl;
-		//If instant
-		if(instant){
-			miCameraX = coords.first;
-			miCameraY = coords.second;
-			meScreen = to;
-			switchUI();
-			return;
-		}
-		//Assign destination screen as current
-		meScreen = to;
-		//Zero current travelled distance
-		miCurrentDistance = 0;
-		//Keep old coordinates
-		miOldTransitionX = miCameraX;
-		miOldTransitionY = miCameraY;
-		//Raise transition flag
-		mbTransition = 1;
-		//Find direction vector
-		mDirection = {coords.first-miOldTransitionX, coords.second-miOldTransitionY};
-		//Find length
-		miDestinationDistance = sqrt(mDirection.first*mDirection.first+mDirection.second*mDirection.second);
-		cout << "Length: " << miDestinationDistance << endl;
-		//If length is 0
-		if(!miDestinationDistance) return;
-		//Normalize vectors
-		mDirection.first/=miDestinationDistance; mDirection.second/=miDestinationDistance;
-		cout << "Transitioning with vector (" << mDirection.first << ", " << mDirection.second << ")" << endl;
+	//Assign destination screen as current
+	meScreen = to;
+	//If instant
+	if(instant){
+		miCameraX = SCREEN_COORDS[to].first;
+		miCameraY = SCREEN_COORDS[to].second;
+		mbTransition = 0;
+		switchUI();
+		return;
 	}
+	//Start from the current camera position (also when already moving)
+	mfFromX = miCameraX;
+	mfFromY = miCameraY;
+	miTransitionStart = Clock::now();
+	//Raise transition flag
+	mbTransition = 1;
+}
 
-	//Calculate coordinates
-	miCameraX+=10*mDirection.first;
-	miCameraY+=10*mDirection.second;
+//Camera tween step
+void Game::updateTransition(){
+	//Transition progress (0-1)
+	float t = 1;
+	if(TRANSITION_DURATION>0) t = (float)(Clock::now()-miTransitionStart)/TRANSITION_DURATION;
+	if(t>1) t = 1;
 
-	//Increase travelled distance
-	miCurrentDistance+=10;
+	//Calculate coordinates
+	float k = ease(t);
+	miCameraX = mfFromX+(SCREEN_COORDS[meScreen].first-mfFromX)*k;
+	miCameraY = mfFromY+(SCREEN_COORDS[meScreen].second-mfFromY)*k;
 
 	//If destination is reached
-	if(miCurrentDistance>=miDestinationDistance){
-		cout << "Transition end" << endl;
-		miCameraX = SCREEN_COORDS[meScreen].first;
-		miCameraY = SCREEN_COORDS[meScreen].second;
-		cout << "New camera: (" << miCameraX << ", " << miCameraY << ")" << endl;
+	if(t>=1){
 		//Lower transition flag
 		mbTransition = 0;
 		//Switch UI
@@ -1057,22 +1582,11 @@ void Game::switchUI(){
 //Destructor
 Game::~Game()
 {
-	//Release unused pawn placeholders
-	for(int i = 0; i < PLAYERS; ++i)
-		for(unsigned j = 0; j < mBoardVector[FINAL_SQUARES[i].first][FINAL_SQUARES[i].second].size(); ++j)
-			if(!mBoardVector[FINAL_SQUARES[i].first][FINAL_SQUARES[i].second].back()->getEColor()){
-				delete mBoardVector[FINAL_SQUARES[i].first][FINAL_SQUARES[i].second].back();
-				mBoardVector[FINAL_SQUARES[i].first][FINAL_SQUARES[i].second].pop_back();
-			}
-
-	//Release player data
-    for(unsigned i = 0; i < mTurnOrder.size(); ++i)
-		delete mTurnOrder[i];
-	
 	//Release dice data
 	for(unsigned i = 0; i < mDice.size(); ++i)
 		delete mDice[i];
 
 	//Release font
+	Resources::remove(mFont);
 	TTF_CloseFont(mFont);
 }
@@ -19,6 +19,20 @@
 #include "Controls.h"
 #include "Recovery.h"
 #include "Volume.h"
+#include "EventRouter.h"
+#include "Clock.h"
+#include "Sprite.h"
+#include "Timeline.h"
+#include "Engine.h"
+#include "Net.h"
+#include "Lockstep.h"
+#include "Profiler.h"
+#include "Metrics.h"
+#include "Resources.h"
+#include "Trace.h"
+#ifdef HOT_RELOAD
+#include "HotReload.h"
+#endif
 
 ///Misc library inclusion
 #include <iostream>
@@ -30,12 +44,18 @@ using std::vector;
 using std::deque;
 #include <algorithm>
 using std::random_shuffle;
+using std::iter_swap;
+using std::find;
+using std::sort;
 #include <cmath>
+#include <cstdio>
+#include <ctime>
 
-//Game screen enum
-enum Screens{
-	BLANK=0, RULES1, RULES2, TITLE, GAME, WIN
-};
+///Pawn index while the server move is awaited
+#define NET_WAIT -2
+
+///Unmeasured frames rendered before every benchmark scene
+#define BENCH_WARMUP 30
 
 class Game {
 
@@ -55,11 +75,9 @@ private:
 	bool mbTransition;
 	bool mbHighlight;
 
-	///Transition data
-	int miOldTransitionX, miOldTransitionY;
-	int miCurrentDistance, miDestinationDistance;
-	pair<float,float> mDirection;
-	Uint32 miTransitionTimer;
+	///Transition data (camera start position and start time)
+	float mfFromX, mfFromY;
+	Uint32 miTransitionStart;
 
 	///Move remaining moves
 	int miRemaining;
@@ -94,6 +112,12 @@ private:
 
 	///Active UI pointer
 	UI* mActiveUI;
+
+	///Event router
+	EventRouter mRouter;
+
+	///Highlighted square picked since last turn update
+	pair<int,int> mHighlightChoice;
 	
     ///Active board layout (top row leftmost square considered 0)
 	vector<Pawn*> mBoardVector[BOARD_HEIGHT][BOARD_WIDTH];
@@ -104,21 +128,62 @@ private:
     ///Active highlighter index vector
     vector<pair<int,int> > mActiveHighlighters;
 
-    ///Ordered player container
+    ///Highlighted squares (same indexing as the highlighter array)
+    bool mbHighlighted[BOARD_HEIGHT][BOARD_WIDTH];
+
+    ///Player pool (players keep their slot for the whole run and are reset in place)
+    Player mPlayers[PLAYERS];
+
+    ///Final square placeholder pool
+    Pawn mPlaceholders[PLAYERS][PAWNS];
+
+    ///Ordered player container (points into the player pool)
     deque<Player*> mTurnOrder;
 
 	//Current screen
 	Screens meScreen;
 
-	///Explosion FX data
+	///Explosion FX sprite
 	Sprite mExplosion;
-	bool mbExplosion;
-	pair<int,int> mExplosionCoords;
 
-	///Shockwave FX data
+	///Shockwave FX sprite
 	Sprite mShockwave;
-	bool mbShockwave;
-	pair<int,int> mShockwaveCoords;
+
+	///Timed FX tracks (turns wait for blocking tracks)
+	Timeline mTimeline;
+
+	///Online match flag (rolls and moves come from the server)
+	bool mbOnline;
+
+	///Server connection
+	Connection mNet;
+
+	///Lockstep peers (used instead of the server connection when mbLockstep is set)
+	Lockstep mLockstep;
+	bool mbLockstep;
+
+	///Received server messages waiting for the game to catch up
+	deque<Message> mNetQueue;
+
+	///Local seat
+	Colors meSeat;
+
+	///Sequence number of the last applied server message
+	unsigned miNetSeq;
+
+	///Move and capture deltas of the last move (checked on the next turn change)
+	vector<Message> mNetDeltas;
+
+	///Server roll and move of the current turn (0 / NET_WAIT if not received)
+	int miNetRoll, miNetMove;
+
+	///Flags if the local roll / move request / snapshot request was sent
+	bool mbNetRolled, mbNetMoved, mbNetResync;
+
+#ifdef HOT_RELOAD
+	///Last applied constants reload
+	unsigned miReloadGeneration;
+#endif
 
 
 public:
@@ -140,12 +205,31 @@ public:
    	///Game data initializing function
     void initGame();
 
-    ///Event handler
+    ///Route current event (called once per polled event)
     void eventHandler();
 
+    ///Join an online match (call after init)
+    ///Args:
+    ///const string& address - server address ("host:port" or socket path)
+    ///int match - match number
+    ///bool watch - follow the match read-only instead of taking a seat
+    bool connect(const string& address, int match, bool watch = 0);
+
+    ///Host or join a lockstep match between peers (call after init)
+    ///Args:
+    ///const string& address - listening or host address
+    ///bool host - host the match instead of joining it
+    bool lockstep(const string& address, bool host);
+
     ///Render assets
     void render();
 
+    ///Render the title, a full board, a capture and the win screen for a number of
+    ///frames each and print FPS and CPU time per frame (call after init, returns 0 on failure)
+    ///Args:
+    ///int frames - measured frames per scene
+    bool benchmark(int frames);
+
     ///Destuctor
     ~Game();
     
@@ -162,9 +246,12 @@ private:
     
 	///Screen transition method
 	///Args:
-	///Screens to - screen to transition to (not required)
+	///Screens to - screen to transition to
 	///bool instant - instant transition (not required)
-	void transition(Screens to = BLANK, bool instant = 0);
+	void transition(Screens to, bool instant = 0);
+
+	///Move camera along the running transition
+	void updateTransition();
 
 	///Player turn
     ///Args:
@@ -191,6 +278,12 @@ private:
 	///int pY - destination Y index
     void collision(Pawn* p, int pX, int pY);
 
+    ///Add explosion FX (blocks the next turn until it ends)
+    ///Args:
+    ///int pX - X index
+    ///int pY - Y index
+    void explode(int pX, int pY);
+
     ///Board square highlighter
     ///Args:
     ///int pX - X coordinate index
@@ -198,13 +291,76 @@ private:
     void highlight(int pX, int pY);
 
     ///Highlighted squares event handler
+    ///Args:
+    ///SDL_Event& e - reference to SDL event container
+    void selectHighlighted(SDL_Event& e);
+
+    ///Get and clear picked highlighted square
     pair<int,int> getHighlightedChoice();
 
-    ///Delay
+    ///Register event handlers
+    void initRouter();
+
+    ///Rules screen click handler
     ///Args:
-    ///Uint32 ms - milliseconds to delay for
-    void delay(Uint32 ms);
-    
+    ///SDL_Event& e - reference to SDL event container
+    void onRulesClick(SDL_Event& e);
+
+    ///Title screen click handler
+    ///Args:
+    ///SDL_Event& e - reference to SDL event container
+    void onTitleClick(SDL_Event& e);
+
+    ///Win screen click handler
+    ///Args:
+    ///SDL_Event& e - reference to SDL event container
+    void onWinClick(SDL_Event& e);
+
+    ///Game screen click handler
+    ///Args:
+    ///SDL_Event& e - reference to SDL event container
+    void onGameClick(SDL_Event& e);
+
+    ///Dice event handler
+    ///Args:
+    ///SDL_Event& e - reference to SDL event container
+    void onDice(SDL_Event& e);
+
+    ///Finish dice roll (SFX and pause before the move)
+    void onRolled();
+
+    ///Read server messages and apply the ones the game is ready for
+    void pollNet();
+
+    ///Ask the server for a snapshot and drop deltas until it arrives
+    void netResync();
+
+    ///Send a command to the server or the lockstep peers
+    void netSend(const Message& m);
+
+    ///Close the server connection or lockstep match
+    void netClose();
+
+    ///Rebuild the game from a snapshot
+    ///Args:
+    ///const Message& m - snapshot message
+    void netSnapshot(const Message& m);
+
+    ///Check the local state against the deltas of the last move
+    ///Args:
+    ///Colors next - player announced for the next turn (NONE at match end)
+    bool netVerify(Colors next);
+
+    ///Apply the server move of the current turn (returns 0 while waiting)
+    ///Args:
+    ///Player* p - pointer to active player
+    bool netMove(Player* p);
+
+    ///Let the local player pick a move and send it
+    ///Args:
+    ///Player* p - pointer to active player
+    void pickNetMove(Player* p);
+
     ///Activate pawn
     ///Args:
     ///Player p* - pointer to player
@@ -216,6 +372,12 @@ private:
 	///int pY - Y index
     pair<int,int> getCoords(int pX, int pY);
 
+    ///Get board position from screen coordinates ({-1,-1} if off the board)
+    ///Args:
+    ///int x - X screen coordinate
+    ///int y - Y screen coordinate
+    pair<int,int> getSquare(int x, int y);
+
     ///Get screen coordinates for final position
     ///Args:
     ///Color c - player color
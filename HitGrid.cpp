@@ -0,0 +1,42 @@
+#include "HitGrid.h"
+
+#include <algorithm>
+using std::max;
+using std::min;
+
+//Constructor
+HitGrid::HitGrid(int cellSize, int w, int h){
+	miCellSize = cellSize;
+	miCols = (w+cellSize-1)/cellSize;
+	miRows = (h+cellSize-1)/cellSize;
+	mCells.resize(miCols*miRows);
+}
+
+//Add target to every cell it overlaps
+void HitGrid::add(SDL_Rect r, int id){
+	Target t = {r, id};
+	int fromX = max(0, r.x/miCellSize), toX = min(miCols-1, (r.x+r.w)/miCellSize);
+	int fromY = max(0, r.y/miCellSize), toY = min(miRows-1, (r.y+r.h)/miCellSize);
+	for(int y = fromY; y <= toY; ++y)
+		for(int x = fromX; x <= toX; ++x)
+			mCells[y*miCols+x].push_back(t);
+}
+
+//Clear all cells
+void HitGrid::clear(){
+	for(unsigned i = 0; i < mCells.size(); ++i)
+		mCells[i].clear();
+}
+
+//Point lookup
+int HitGrid::find(int x, int y) const {
+	//Outside of indexed area
+	if(x<0 || y<0 || x/miCellSize>=miCols || y/miCellSize>=miRows) return 0;
+	//Check the few targets in the cell (latest first)
+	const vector<Target>& cell = mCells[(y/miCellSize)*miCols+x/miCellSize];
+	for(int i = cell.size()-1; i >= 0; --i){
+		const SDL_Rect& r = cell[i].rect;
+		if(x>=r.x && x<=r.x+r.w && y>=r.y && y<=r.y+r.h) return cell[i].id;
+	}
+	return 0;
+}
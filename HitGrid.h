@@ -0,0 +1,55 @@
+///Uniform grid hit-testing index
+
+#ifndef HITGRID_H
+#define HITGRID_H
+
+///Include local modules
+#include "Shared.h"
+
+///Misc library inclusion
+#include <vector>
+using std::vector;
+
+class HitGrid{
+public:
+
+	///Constructor
+	///Args:
+	///int cellSize - grid cell size in pixels (not required)
+	///int w - indexed area width (not required)
+	///int h - indexed area height (not required)
+	HitGrid(int cellSize = 50, int w = WIDTH, int h = HEIGHT);
+
+	///Register target rectangle
+	///Args:
+	///SDL_Rect r - target rectangle
+	///int id - target id (non zero)
+	void add(SDL_Rect r, int id);
+
+	///Remove all targets
+	void clear();
+
+	///Find target at point
+	///Args:
+	///int x - X coordinate
+	///int y - Y coordinate
+	///Returns:
+	///id of the last added target containing the point (0 if none)
+	int find(int x, int y) const;
+
+private:
+
+	///Indexed target
+	struct Target{
+		SDL_Rect rect;
+		int id;
+	};
+
+	///Grid dimensions
+	int miCellSize, miCols, miRows;
+
+	///Targets overlapping each cell
+	vector<vector<Target> > mCells;
+};
+
+#endif
@@ -0,0 +1,192 @@
+#include "HotReload.h"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+#include <cstdlib>
+#include <cstring>
+
+//Reloadable values (defaults from the generated header)
+#define X(type, name, value) type name = value;
+TUNABLES(X)
+#undef X
+
+unsigned HotReload::generation = 0;
+int HotReload::miFd = -1;
+int HotReload::miRoot = -1;
+int HotReload::miGFX = -1;
+int HotReload::miSFX = -1;
+map<string, string> HotReload::mPaths;
+
+//Container type for a value read from file
+template<class T> struct Staged{ typedef T type; };
+template<> struct Staged<const char*>{ typedef string type; };
+
+
+
+
+bool HotReload::init(){
+#ifdef __linux__
+	//Open non-blocking watcher
+	miFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if(miFd<0){
+		cerr << "Hot reload error: cannot start inotify" << endl;
+		return 0;
+	}
+
+	//Editors often save by renaming a temporary file, so watch directories
+	Uint32 mask = IN_CLOSE_WRITE | IN_MOVED_TO;
+	miRoot = inotify_add_watch(miFd, ".", mask);
+	miGFX = inotify_add_watch(miFd, "GFX", mask);
+	miSFX = inotify_add_watch(miFd, "SFX", mask);
+	if(miRoot<0 || miGFX<0 || miSFX<0)
+		cerr << "Hot reload error: cannot watch asset directories" << endl;
+
+#ifdef DEBUG
+	cout << "Hot reload watching Constants.xml, GFX/, SFX/" << endl;
+#endif
+	return 1;
+#else
+	cerr << "Hot reload is only available on Linux" << endl;
+	return 0;
+#endif
+}
+
+
+
+
+void HotReload::poll(){
+#ifdef __linux__
+	if(miFd<0) return;
+
+	//Collect changed files (several events per file are merged)
+	bool constants = 0;
+	set<string> textures, sounds;
+	char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+	ssize_t length;
+	while((length = ::read(miFd, buffer, sizeof(buffer))) > 0){
+		for(char* p = buffer; p < buffer+length; ){
+			inotify_event* e = (inotify_event*)p;
+			p += sizeof(inotify_event)+e->len;
+			if(e->len==0) continue;
+			string name = e->name;
+			if(e->wd==miRoot && name=="Constants.xml") constants = 1;
+			else if(e->wd==miGFX) textures.insert("GFX/"+name);
+			else if(e->wd==miSFX) sounds.insert("SFX/"+name);
+		}
+	}
+
+	//Apply changes
+	if(constants) reloadConstants();
+	for(set<string>::iterator it = textures.begin(); it!=textures.end(); ++it){
+#ifdef DEBUG
+		cout << "Reloading " << *it << endl;
+#endif
+		Texture::reload(*it, *it);
+	}
+	for(set<string>::iterator it = sounds.begin(); it!=sounds.end(); ++it){
+#ifdef DEBUG
+		cout << "Reloading " << *it << endl;
+#endif
+		Sound::reload(*it);
+	}
+#endif
+}
+
+
+
+
+void HotReload::free(){
+#ifdef __linux__
+	if(miFd>=0) close(miFd);
+	miFd = -1;
+#endif
+}
+
+
+
+
+bool HotReload::reloadConstants(){
+	//Load file
+	pugi::xml_document doc;
+	if(!doc.load_file("Constants.xml")){
+		cerr << "Hot reload error: cannot parse Constants.xml" << endl;
+		return 0;
+	}
+	pugi::xml_node root = doc.child("constants");
+
+	//Read every value before changing any
+	bool valid = 1;
+#define X(T, name, value) Staged<T>::type new_##name; \
+	valid = read(root, #name, new_##name) && valid;
+	TUNABLES(X)
+#undef X
+	if(!valid){
+		cerr << "Hot reload error: Constants.xml not applied" << endl;
+		return 0;
+	}
+
+	//Apply values
+#define X(type, name, value) apply(name, new_##name, #name);
+	TUNABLES(X)
+#undef X
+
+	generation++;
+#ifdef DEBUG
+	cout << "Constants.xml reloaded" << endl;
+#endif
+	return 1;
+}
+
+
+
+
+void HotReload::apply(int& to, int from, const char*){
+	to = from;
+}
+
+void HotReload::apply(const char*& to, const string& from, const char* name){
+	if(from==to) return;
+	//Keep path text alive and reload textures loaded from the old path
+	string old = to;
+	mPaths[name] = from;
+	to = mPaths[name].c_str();
+	Texture::reload(old, to);
+}
+
+
+
+
+//Find element by name anywhere below a node
+static pugi::xml_node find(pugi::xml_node n, const char* name){
+	for(pugi::xml_node c = n.first_child(); c; c = c.next_sibling()){
+		if(!strcmp(c.name(), name)) return c;
+		pugi::xml_node found = find(c, name);
+		if(found) return found;
+	}
+	return pugi::xml_node();
+}
+
+bool HotReload::read(pugi::xml_node root, const char* name, int& out){
+	pugi::xml_node n = find(root, name);
+	string text = n.text().as_string();
+	char* end;
+	long value = strtol(text.c_str(), &end, 0);
+	if(!n || text.empty() || *end!='\0'){
+		cerr << "Hot reload error: " << name << " is not an integer" << endl;
+		return 0;
+	}
+	out = value;
+	return 1;
+}
+
+bool HotReload::read(pugi::xml_node root, const char* name, string& out){
+	pugi::xml_node n = find(root, name);
+	if(!n){
+		cerr << "Hot reload error: " << name << " is missing" << endl;
+		return 0;
+	}
+	out = n.text().as_string();
+	return 1;
+}
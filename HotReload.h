@@ -0,0 +1,71 @@
+///Live reloading of Constants.xml and assets (HOT_RELOAD builds)
+
+#ifndef HOTRELOAD_H
+#define HOTRELOAD_H
+
+///Include local modules
+#include "Shared.h"
+#include "Texture.h"
+#include "Sound.h"
+
+///Misc library inclusion
+#include "pugixml.hpp"
+#include <iostream>
+using std::cerr;
+using std::endl;
+#include <string>
+using std::string;
+#include <set>
+using std::set;
+#include <map>
+using std::map;
+
+class HotReload{
+public:
+
+	///Start watching Constants.xml, GFX/ and SFX/
+	///(returns 0 if watching is not available)
+	static bool init();
+
+	///Apply pending changes (called once between frames)
+	static void poll();
+
+	///Stop watching
+	static void free();
+
+	///Incremented after every Constants.xml reload
+	static unsigned generation;
+
+private:
+
+	///Read reloadable values from Constants.xml and apply them
+	///(all values are applied together, or none on error)
+	static bool reloadConstants();
+
+	///Read a value by element name
+	///Args:
+	///pugi::xml_node root - document root
+	///const char* name - element name
+	///int/string& out - value container
+	static bool read(pugi::xml_node root, const char* name, int& out);
+	static bool read(pugi::xml_node root, const char* name, string& out);
+
+	///Store a value read from file
+	///Args:
+	///int/const char*& to - reloadable value
+	///int/string from - new value
+	///const char* name - value name
+	static void apply(int& to, int from, const char* name);
+	static void apply(const char*& to, const string& from, const char* name);
+
+	///Inotify descriptor
+	static int miFd;
+
+	///Watch descriptors (Constants.xml directory, GFX/, SFX/)
+	static int miRoot, miGFX, miSFX;
+
+	///Storage for reloaded path strings
+	static map<string, string> mPaths;
+};
+
+#endif
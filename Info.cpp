@@ -20,9 +20,7 @@ int Info::eventHandler(SDL_Event& e) {
 	int ButtonState = 0;
 	//event timer
 	if(UI::debounce()){
-		ButtonState|=(pageNext.isClicked(e));
-		ButtonState<<=1;
-		ButtonState|=(pageBack.isClicked(e));
+		ButtonState = UI::clicked(e);
 	}
 	return ButtonState;
 }
@@ -45,6 +43,10 @@ void Info::init() {
 
 	pageNext.setLocation((WIDTH-RULES_WIDTH),(HEIGHT-RULES_HEIGHT)/2);
 	pageBack.setLocation(0,(HEIGHT-RULES_HEIGHT)/2);
+
+	//register the buttons for hit testing
+	UI::addButton(pageNext, RULES_NEXT);
+	UI::addButton(pageBack, RULES_BACK);
 	
 }
 // render function that draws the image on the screen
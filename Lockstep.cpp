@@ -0,0 +1,525 @@
+#include "Lockstep.h"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <poll.h>
+#endif
+#include <algorithm>
+
+//Constructor
+Lockstep::Lockstep()
+:mRandom(std::random_device()()){
+	miListener = -1;
+	close();
+}
+
+//Destructor
+Lockstep::~Lockstep(){
+	close();
+}
+
+//Host match
+bool Lockstep::host(const string& address, int seats){
+	close();
+	miListener = Net::listen(address);
+	if(miListener<0) return 0;
+	mbOpen = 1;
+	mbHost = 1;
+	miSeats = std::max(1, std::min(seats, PLAYERS));
+	for(int i = 0; i < miSeats; ++i) mOwners[i] = SEAT_LOCAL;
+	return 1;
+}
+
+//Join match
+bool Lockstep::join(const string& address, int seats){
+	close();
+	Link* l = new Link;
+	l->greeted = 0;
+	if(!l->net.open(address)){
+		delete l;
+		return 0;
+	}
+	mLinks.push_back(l);
+	mbOpen = 1;
+	miSeats = std::max(1, std::min(seats, PLAYERS-1));
+	Message hello(MSG_HELLO);
+	hello.value = PROTOCOL_VERSION;
+	l->net.send(hello);
+	Message join(MSG_JOIN);
+	join.value = miSeats;
+	l->net.send(join);
+	return 1;
+}
+
+//Close links and forget the match
+void Lockstep::close(){
+	for(unsigned i = 0; i < mLinks.size(); ++i){
+		mLinks[i]->net.flush();
+		delete mLinks[i];
+	}
+	mLinks.clear();
+	Net::close(miListener);
+	miListener = -1;
+	mbOpen = 0;
+	mbHost = 0;
+	mbSeated = 0;
+	mbStarted = 0;
+	miSeats = 0;
+	for(int i = 0; i < PLAYERS; ++i){
+		mOwners[i] = SEAT_FREE;
+		miSent[i] = -1;
+		mNext[i] = 0;
+	}
+	mRounds.clear();
+	mChoices.clear();
+	mAnswers.clear();
+	mEngine = Engine();
+	miSeq = 0;
+	miTraffic = 0;
+}
+
+
+
+
+//Local player command
+void Lockstep::send(const Message& m){
+	Colors c = mEngine.getCurrent();
+	int round = getRound();
+	if(m.type==MSG_RESYNC){
+		if(mbStarted) mAnswers.push_back(snapshot());
+	}
+	else if(!mbStarted || mEngine.isOver() || !isLocal(c)) refuse(ERR_NOT_YOUR_TURN);
+	//Reveal the nonce of the roll
+	else if(m.type==MSG_ROLL_REQUEST){
+		if(mEngine.getRoll() || miSent[c-1]>=round) refuse(ERR_ROLLED);
+		else tick(c, round);
+	}
+	//Pick a pawn
+	else if(m.type==MSG_MOVE_REQUEST){
+		vector<int> moves = mEngine.getMoves();
+		if(!mEngine.getRoll()) refuse(ERR_ROLL_FIRST);
+		else if(mChoices.count(round) || find(moves.begin(), moves.end(), m.pawn)==moves.end()) refuse(ERR_ILLEGAL);
+		else {
+			Message choice(MSG_CHOICE);
+			choice.seq = round;
+			choice.color = c;
+			choice.pawn = m.pawn;
+			mChoices[round] = choice;
+			relay(choice, -1);
+		}
+	}
+	else refuse(ERR_UNEXPECTED);
+}
+
+//Refuse local command
+void Lockstep::refuse(ErrorCodes code){
+	Message error(MSG_ERROR);
+	error.value = code;
+	mAnswers.push_back(error);
+}
+
+//Exchange messages
+void Lockstep::poll(deque<Message>& out){
+	out.insert(out.end(), mAnswers.begin(), mAnswers.end());
+	mAnswers.clear();
+	if(!mbOpen) return;
+	if(miListener>=0) accept();
+
+	//Read links (a handled message may close the match)
+	vector<unsigned> closed;
+	for(unsigned i = 0; mbOpen && i < mLinks.size(); ++i){
+		Link* l = mLinks[i];
+		if(!l->net.isOpen()) continue;
+		size_t buffered = l->net.getInput().size();
+		bool open = l->net.receive();
+		miTraffic += l->net.getInput().size()-buffered;
+		Message m;
+		int result = 0;
+		while(mbOpen && l->net.isOpen() && (result = l->net.next(m))>0)
+			handle(i, m, out);
+		if(!open || result<0) closed.push_back(i);
+	}
+	if(!mbOpen) return;
+
+	//Host starts once all seats are taken
+	if(mbHost && !mbSeated && std::count(mOwners, mOwners+PLAYERS, SEAT_FREE)==0) start(out);
+	//The last message of a closed link may end the match
+	advance(out);
+	for(unsigned i = 0; mbOpen && i < closed.size(); ++i)
+		if(mLinks[closed[i]]->net.isOpen()) lost(closed[i], out);
+
+	//Write queued messages
+	for(unsigned i = 0; mbOpen && i < mLinks.size(); ++i)
+		if(mLinks[i]->net.isOpen() && !mLinks[i]->net.flush()) lost(i, out);
+}
+
+//Wait for input
+bool Lockstep::wait(int timeout){
+#ifndef _WIN32
+	vector<pollfd> fds;
+	pollfd p;
+	p.events = POLLIN;
+	p.revents = 0;
+	if(miListener>=0){ p.fd = miListener; fds.push_back(p); }
+	//Queued messages are written by the next poll
+	for(unsigned i = 0; i < mLinks.size(); ++i){
+		if(!mLinks[i]->net.isOpen()) continue;
+		p.fd = mLinks[i]->net.getFd();
+		p.events = POLLIN | (mLinks[i]->net.hasOutput() ? POLLOUT : 0);
+		fds.push_back(p);
+	}
+	if(fds.empty()) return 1;
+	return ::poll(&fds[0], fds.size(), timeout)>0;
+#else
+	return 1;
+#endif
+}
+
+
+
+
+//Accept peers
+void Lockstep::accept(){
+#ifndef _WIN32
+	while(1){
+		int fd = ::accept(miListener, NULL, NULL);
+		if(fd<0) break;
+		if(!Net::setNonBlocking(fd)){
+			Net::close(fd);
+			continue;
+		}
+		Link* l = new Link;
+		l->net.attach(fd);
+		l->greeted = 0;
+		mLinks.push_back(l);
+	}
+#endif
+}
+
+//Handle link message
+void Lockstep::handle(unsigned link, const Message& m, deque<Message>& out){
+	Link* l = mLinks[link];
+	//Version check comes first
+	if(!l->greeted){
+		if(m.type!=MSG_HELLO || m.value!=PROTOCOL_VERSION){
+			if(!mbHost){
+				abort("host speaks another protocol version", NONE, out);
+				return;
+			}
+			Message error(MSG_ERROR);
+			error.value = ERR_VERSION;
+			l->net.send(error);
+			l->net.flush();
+			lost(link, out);
+			return;
+		}
+		if(mbHost) l->net.send(m);
+		l->greeted = 1;
+		return;
+	}
+
+	switch(m.type){
+		//Seat request (host)
+		case MSG_JOIN:
+			if(mbHost) seat(link, m.value, out);
+			break;
+		//Seat given by the host (the match starts when all requested seats are given)
+		case MSG_SEAT:
+			if(mbHost || mbSeated || mOwners[m.color-1]!=SEAT_FREE) break;
+			mOwners[m.color-1] = SEAT_LOCAL;
+			if(std::count(mOwners, mOwners+PLAYERS, SEAT_LOCAL)<miSeats) break;
+			for(int i = 0; i < PLAYERS; ++i)
+				if(mOwners[i]==SEAT_FREE) mOwners[i] = 0;
+			start(out);
+			break;
+		//Nonce and pawn choice of another peer
+		case MSG_TICK:
+		case MSG_CHOICE:
+			if(!mbSeated || mOwners[m.color-1]!=(mbHost ? (int)link : 0) || !store(m)){
+				abort("unexpected message from a peer", NONE, out);
+				return;
+			}
+			if(mbHost) relay(m, link);
+			break;
+		//State of the host after a desync
+		case MSG_SNAPSHOT:
+			if(mbHost) break;
+			cerr << "Lockstep: out of sync, state of turn " << m.turn << " loaded from the host" << endl;
+			load(m.players, m.turn, m.roll);
+			out.push_back(snapshot());
+			break;
+		case MSG_LEFT:
+			if(!mbHost) abort("a player left the match", m.color, out);
+			break;
+		case MSG_ERROR:
+			if(!mbHost){
+				cerr << "Lockstep: host refused the peer: error " << m.value << endl;
+				abort("cannot join", NONE, out);
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+//Seat peer
+void Lockstep::seat(unsigned link, int seats, deque<Message>& out){
+	int free = std::count(mOwners, mOwners+PLAYERS, SEAT_FREE);
+	if(std::count(mOwners, mOwners+PLAYERS, (int)link) || seats<1 || seats>free){
+		Message error(MSG_ERROR);
+		error.value = ERR_FULL;
+		mLinks[link]->net.send(error);
+		mLinks[link]->net.flush();
+		lost(link, out);
+		return;
+	}
+	for(int i = 0; i < PLAYERS && seats; ++i){
+		if(mOwners[i]!=SEAT_FREE) continue;
+		mOwners[i] = link;
+		seats--;
+	}
+}
+
+//Start sealing rounds
+void Lockstep::start(deque<Message>& out){
+	mbSeated = 1;
+	Net::close(miListener);
+	miListener = -1;
+	//Tell every process its seats
+	for(int i = 0; i < PLAYERS; ++i){
+		Message seat(MSG_SEAT);
+		seat.color = Colors(i+1);
+		if(mOwners[i]==SEAT_LOCAL) out.push_back(seat);
+		else if(mbHost) mLinks[mOwners[i]]->net.send(seat);
+	}
+	//Round 0 only seals the nonces of round 1
+	for(int i = 0; i < PLAYERS; ++i)
+		if(mOwners[i]==SEAT_LOCAL) tick(Colors(i+1), 0);
+}
+
+
+
+
+//Apply complete rounds and choices
+void Lockstep::advance(deque<Message>& out){
+	while(mbOpen && mbSeated && !mEngine.isOver()){
+		int round = getRound();
+
+		//Rolled: wait for the pawn choice of the current player
+		if(mEngine.getRoll()){
+			map<int, Message>::iterator it = mChoices.find(round);
+			if(it==mChoices.end()) return;
+			vector<Message> changes;
+			if(it->second.color!=mEngine.getCurrent() || !Protocol::play(mEngine, it->second.pawn, miSeq, changes)){
+				abort("illegal move from a peer", NONE, out);
+				return;
+			}
+			out.insert(out.end(), changes.begin(), changes.end());
+			continue;
+		}
+
+		//Reveal local nonces once every seat has sealed them (the current player reveals by rolling)
+		if(!isComplete(round-1)) return;
+		for(int i = 0; i < PLAYERS; ++i){
+			Colors seat = Colors(i+1);
+			if(mOwners[i]==SEAT_LOCAL && miSent[i]<round && (!mbStarted || seat!=mEngine.getCurrent()))
+				tick(seat, round);
+		}
+		if(!isComplete(round)) return;
+
+		//Random value of the round (every nonce must match its seal)
+		const Round& r = mRounds[round];
+		const Round& sealed = mRounds[round-1];
+		unsigned value = 0;
+		for(int i = 0; i < PLAYERS; ++i){
+			if(seal(r.nonce[i], round, Colors(i+1))!=sealed.commit[i]){
+				abort("a peer revealed a nonce it had not sealed", NONE, out);
+				return;
+			}
+			value = seal(value ^ r.nonce[i], round, NONE);
+		}
+
+		//Host sends its state to peers that drifted
+		if(mbHost && mbStarted){
+			vector<bool> drifted(mLinks.size(), 0);
+			for(int i = 0; i < PLAYERS; ++i)
+				if(mOwners[i]>=0 && r.hash[i]!=mEngine.getHash()) drifted[mOwners[i]] = 1;
+			for(unsigned i = 0; i < mLinks.size(); ++i){
+				if(!drifted[i]) continue;
+				cerr << "Lockstep: peer out of sync at turn " << mEngine.getTurn() << ", sending state" << endl;
+				mLinks[i]->net.send(snapshot());
+			}
+		}
+
+		//Keep the previous round (a snapshot may rewind one round)
+		mRounds.erase(mRounds.begin(), mRounds.lower_bound(round-1));
+		mChoices.erase(mChoices.begin(), mChoices.lower_bound(round-1));
+
+		//Turn order
+		if(!mbStarted){
+			mEngine.newGame(value);
+			mbStarted = 1;
+			out.push_back(snapshot());
+			Message turn(MSG_TURN);
+			turn.seq = ++miSeq;
+			turn.color = mEngine.getCurrent();
+			out.push_back(turn);
+			continue;
+		}
+
+		//Dice roll (turns without a choice are played right away)
+		Message roll(MSG_ROLL);
+		roll.seq = ++miSeq;
+		roll.color = mEngine.getCurrent();
+		roll.value = value%6+1;
+		mEngine.setRoll(roll.value);
+		out.push_back(roll);
+		vector<int> moves = mEngine.getMoves();
+		if(moves.size()<=1){
+			Message choice(MSG_CHOICE);
+			choice.seq = round;
+			choice.color = roll.color;
+			choice.pawn = moves.empty() ? PASS : moves[0];
+			mChoices[round] = choice;
+		}
+	}
+}
+
+//Reveal nonce and seal the next one
+void Lockstep::tick(Colors seat, int round){
+	int i = seat-1;
+	Message m(MSG_TICK);
+	m.seq = round;
+	m.color = seat;
+	m.value = round ? mNext[i] : 0;
+	mNext[i] = mRandom();
+	m.commit = seal(mNext[i], round+1, seat);
+	m.hash = mbStarted ? mEngine.getHash() : 0;
+	miSent[i] = round;
+	store(m);
+	relay(m, -1);
+}
+
+//Store peer message
+bool Lockstep::store(const Message& m){
+	//Peers are never more than a round apart
+	int round = m.seq;
+	if(round<getRound()-2 || round>getRound()+2) return 0;
+	if(m.type==MSG_CHOICE){
+		map<int, Message>::iterator it = mChoices.find(round);
+		if(it!=mChoices.end()) return it->second.pawn==m.pawn;
+		mChoices[round] = m;
+		return 1;
+	}
+	if(!mRounds.count(round)){
+		Round& r = mRounds[round];
+		for(int i = 0; i < PLAYERS; ++i) r.revealed[i] = 0;
+	}
+	Round& r = mRounds[round];
+	int i = m.color-1;
+	if(r.revealed[i]) return 0;
+	r.revealed[i] = 1;
+	r.nonce[i] = m.value;
+	r.commit[i] = m.commit;
+	r.hash[i] = m.hash;
+	return 1;
+}
+
+//Send to other links
+void Lockstep::relay(const Message& m, int except){
+	Frame frame = Net::frame(m);
+	for(unsigned i = 0; i < mLinks.size(); ++i)
+		if((int)i!=except && mLinks[i]->net.isOpen()) mLinks[i]->net.send(frame);
+}
+
+//Close match
+void Lockstep::abort(const string& reason, Colors seat, deque<Message>& out){
+	cerr << "Lockstep: " << reason << endl;
+	Message left(MSG_LEFT);
+	left.color = seat;
+	if(mbHost) relay(left, -1);
+	out.push_back(left);
+	close();
+}
+
+//Lost link
+void Lockstep::lost(unsigned link, deque<Message>& out){
+	mLinks[link]->net.close();
+	Colors seat = NONE;
+	for(int i = 0; i < PLAYERS; ++i){
+		if(mOwners[i]!=(int)link) continue;
+		seat = Colors(i+1);
+		//Seats of a peer that left before the start are free again
+		if(mbHost && !mbSeated) mOwners[i] = SEAT_FREE;
+	}
+	//Links close normally after the match
+	if((mbHost && !mbSeated) || mEngine.isOver()) return;
+	abort(mbHost ? "a peer left the match" : "connection to the host lost", seat, out);
+}
+
+//Full local state
+Message Lockstep::snapshot() const {
+	Message state(MSG_SNAPSHOT);
+	state.seq = miSeq;
+	state.players = mEngine.getPlayers();
+	state.turn = mEngine.getTurn();
+	state.roll = mEngine.getRoll();
+	return state;
+}
+
+
+
+
+//Getters
+bool Lockstep::isOpen() const {
+	return mbOpen;
+}
+
+bool Lockstep::isLocal(Colors seat) const {
+	return seat!=NONE && mOwners[seat-1]==SEAT_LOCAL;
+}
+
+const Engine& Lockstep::getEngine() const {
+	return mEngine;
+}
+
+size_t Lockstep::getTraffic() const {
+	return miTraffic;
+}
+
+//Replace local state
+void Lockstep::load(const vector<PlayerRecord>& players, int turn, int roll){
+	mEngine.load(players, turn, roll);
+	mbStarted = 1;
+}
+
+//Round of the next random value
+int Lockstep::getRound() const {
+	return mbStarted ? mEngine.getTurn()+2 : 1;
+}
+
+//Check if all seats revealed a round
+bool Lockstep::isComplete(int round) const {
+	map<int, Round>::const_iterator it = mRounds.find(round);
+	if(it==mRounds.end()) return 0;
+	for(int i = 0; i < PLAYERS; ++i)
+		if(!it->second.revealed[i]) return 0;
+	return 1;
+}
+
+//Seal a nonce (FNV-1a with a final avalanche)
+unsigned Lockstep::seal(unsigned nonce, int round, Colors seat){
+	unsigned hash = 2166136261u;
+	unsigned words[3] = {nonce, (unsigned)round, (unsigned)seat};
+	for(int w = 0; w < 3; ++w)
+		for(int i = 0; i < 4; ++i){
+			hash ^= (words[w]>>(i*8)) & 0xff;
+			hash *= 16777619u;
+		}
+	hash ^= hash>>16;
+	hash *= 0x85ebca6bu;
+	hash ^= hash>>13;
+	hash *= 0xc2b2ae35u;
+	hash ^= hash>>16;
+	return hash;
+}
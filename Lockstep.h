@@ -0,0 +1,198 @@
+///Peer-to-peer lockstep matches (no server, every peer runs the Engine)
+
+#ifndef LOCKSTEP_H
+#define LOCKSTEP_H
+
+///Include local modules
+#include "Engine.h"
+#include "Net.h"
+
+///Misc library inclusion
+#include <map>
+using std::map;
+#include <random>
+
+///Peers only exchange dice nonces and pawn choices; the host relays them and
+///seats the peers, but has no more authority over the rules than anyone else.
+///Dice use commit-reveal rounds: every TICK reveals the nonce of one round and
+///seals the nonce of the next, so no peer can pick its nonce after seeing the
+///others. Round 1 seeds the turn order, round N+2 is the roll of turn N.
+///Each TICK also carries the state hash of its sender; the host answers a
+///mismatching peer with a SNAPSHOT of its own state.
+///Seals are 32-bit, enough to keep honest clients honest, not to stop a
+///determined cheater.
+
+///Seat owners (other values are link indices)
+#define SEAT_FREE -2
+#define SEAT_LOCAL -1
+
+class Lockstep{
+public:
+
+	///Constructor
+	Lockstep();
+
+	///Destructor (closes all links)
+	~Lockstep();
+
+	///Host a match and take the first seats (peers join until all are taken)
+	///Args:
+	///const string& address - listening address
+	///int seats - seats played in this process
+	bool host(const string& address, int seats);
+
+	///Join a hosted match
+	///Args:
+	///const string& address - host address
+	///int seats - seats played in this process
+	bool join(const string& address, int seats);
+
+	///Handle a command of the local player to move (ROLL_REQUEST, MOVE_REQUEST or RESYNC)
+	///Args:
+	///const Message& m - command
+	void send(const Message& m);
+
+	///Exchange messages with the other peers and append what a server would send
+	///(SEAT, SNAPSHOT, TURN, ROLL, MOVE, CAPTURE, END, LEFT, ERROR)
+	///Args:
+	///deque<Message>& out - match messages
+	void poll(deque<Message>& out);
+
+	///Wait until a peer sends something (returns 0 on timeout)
+	///Args:
+	///int timeout - milliseconds
+	bool wait(int timeout);
+
+	///Close all links
+	void close();
+
+	///Getters
+	bool isOpen() const;
+	bool isLocal(Colors seat) const;
+	const Engine& getEngine() const;
+	size_t getTraffic() const;
+
+	///Replace the local state (ludo-peer --desync uses it to test recovery)
+	///Args:
+	///const vector<PlayerRecord>& players - players in turn order
+	///int turn - finished turns
+	///int roll - roll of the current player
+	void load(const vector<PlayerRecord>& players, int turn, int roll);
+
+private:
+
+	///Connection to another peer
+	struct Link{
+		Connection net;
+		///Flag if the protocol version was accepted
+		bool greeted;
+	};
+
+	///Nonces of one round
+	struct Round{
+		bool revealed[PLAYERS];
+		unsigned nonce[PLAYERS], commit[PLAYERS], hash[PLAYERS];
+	};
+
+	///Copying would close the links twice
+	Lockstep(const Lockstep&);
+	Lockstep& operator=(const Lockstep&);
+
+	///Accept joining peers (host)
+	void accept();
+
+	///Handle one message of a link
+	///Args:
+	///unsigned link - link index
+	///const Message& m - message
+	///deque<Message>& out - match messages
+	void handle(unsigned link, const Message& m, deque<Message>& out);
+
+	///Seat a joining peer (host)
+	void seat(unsigned link, int seats, deque<Message>& out);
+
+	///All seats are taken: seal the first round
+	void start(deque<Message>& out);
+
+	///Apply every round and choice that is complete
+	void advance(deque<Message>& out);
+
+	///Reveal the nonce of a round for a local seat and seal the next one
+	void tick(Colors seat, int round);
+
+	///Store a revealed nonce (returns 0 if the message is not acceptable)
+	bool store(const Message& m);
+
+	///Send to every link but one
+	///Args:
+	///const Message& m - message
+	///int except - link index to skip (-1 for none)
+	void relay(const Message& m, int except);
+
+	///Lost link or broken rule: close the match
+	///Args:
+	///const string& reason - printed reason
+	///Colors seat - seat that left (NONE if unknown)
+	void abort(const string& reason, Colors seat, deque<Message>& out);
+
+	///Link closed by the other side or unusable
+	void lost(unsigned link, deque<Message>& out);
+
+	///Full local state
+	Message snapshot() const;
+
+	///Refuse a local command
+	void refuse(ErrorCodes code);
+
+	///Round of the next random value (1: turn order, N+2: roll of turn N)
+	int getRound() const;
+
+	///Check if every seat revealed a round
+	bool isComplete(int round) const;
+
+	///Seal of a nonce
+	static unsigned seal(unsigned nonce, int round, Colors seat);
+
+	///Flags if a match is open and if this process hosts it
+	bool mbOpen, mbHost;
+
+	///Flags if all seats were taken and if the match has a turn order
+	bool mbSeated, mbStarted;
+
+	///Listening socket (host, -1 once all seats are taken)
+	int miListener;
+
+	///Links (the host has one per peer, a peer only the one to the host)
+	vector<Link*> mLinks;
+
+	///Seats requested by this process (peer)
+	int miSeats;
+
+	///Seat owners (SEAT_FREE, SEAT_LOCAL or a link index)
+	int mOwners[PLAYERS];
+
+	///Last round revealed by each local seat and its sealed nonce
+	int miSent[PLAYERS];
+	unsigned mNext[PLAYERS];
+
+	///Revealed nonces and pawn choices by round
+	map<int, Round> mRounds;
+	map<int, Message> mChoices;
+
+	///Answers to local commands (given out by the next poll)
+	deque<Message> mAnswers;
+
+	///Local match state
+	Engine mEngine;
+
+	///Sequence number of the match messages given to the caller
+	unsigned miSeq;
+
+	///Received bytes
+	size_t miTraffic;
+
+	///Nonce source
+	std::mt19937 mRandom;
+};
+
+#endif
@@ -0,0 +1,196 @@
+#include "Metrics.h"
+#include "Net.h"
+#include "Resources.h"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <poll.h>
+#include <unistd.h>
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+#endif
+#include <cstdio>
+
+std::atomic<unsigned long long> Metrics::miCounters[METRIC_COUNTERS];
+Metrics::Histogram Metrics::mHistograms[METRIC_HISTOGRAMS];
+Uint64 Metrics::miLastFrame = 0;
+SDL_Thread* Metrics::mThread = NULL;
+std::atomic<bool> Metrics::mbStop(false);
+int Metrics::miListener = -1;
+string Metrics::msAddress;
+string Metrics::msFile;
+
+//Exported names and help lines
+static const char* COUNTER_NAMES[METRIC_COUNTERS][2] = {
+	{"ludo_frames_total", "Frames rendered"},
+	{"ludo_turns_total", "Turns played"},
+	{"ludo_saves_total", "Recovery.xml saves written"},
+	{"ludo_audio_underruns_total", "Late audio buffers"}};
+static const char* HISTOGRAM_NAMES[METRIC_HISTOGRAMS][2] = {
+	{"ludo_frame_ms", "Frame time"},
+	{"ludo_save_ms", "Recovery.xml save time"}};
+static const char* RESOURCE_NAMES[RESOURCE_KINDS] = {"texture", "text", "font", "sound"};
+
+//Bucket upper bounds (ms, the last one is +Inf)
+static const double BUCKETS[METRIC_BUCKETS-1] = {1, 2, 4, 8, 12, 16.7, 20, 33.3, 50, 100, 1000};
+
+//Serving thread wake up interval (ms, also the stop latency)
+#define SERVE_WAIT 100
+
+void Metrics::count(MetricCounters c){
+	miCounters[c].fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::observe(MetricHistograms h, double ms){
+	int b = 0;
+	while(b < METRIC_BUCKETS-1 && ms>BUCKETS[b]) b++;
+	Histogram& histogram = mHistograms[h];
+	histogram.buckets[b].fetch_add(1, std::memory_order_relaxed);
+	histogram.sumUs.fetch_add(ms>0 ? (unsigned long long)(ms*1000) : 0, std::memory_order_relaxed);
+}
+
+void Metrics::frame(){
+	Uint64 now = SDL_GetPerformanceCounter();
+	if(miLastFrame){
+		count(METRIC_FRAMES);
+		observe(HISTOGRAM_FRAME, (double)(now-miLastFrame)*1000/SDL_GetPerformanceFrequency());
+	}
+	miLastFrame = now;
+}
+
+
+
+
+bool Metrics::start(const string& address, const string& file){
+	msAddress = address;
+	msFile = file;
+	if(!address.empty()){
+		//Local endpoint only (a host:port would let anyone scrape the installation)
+		if(address.find('/')==string::npos){
+			cerr << "Metrics error: " << address << " is not a socket path (use ./" << address << ")" << endl;
+			return 0;
+		}
+		miListener = Net::listen(address);
+		if(miListener<0) return 0;
+	}
+	mbStop = 0;
+	mThread = SDL_CreateThread(serve, "metrics", NULL);
+	if(mThread==NULL){
+		cerr << "Metrics error: " << SDL_GetError() << endl;
+		Net::close(miListener);
+		miListener = -1;
+		return 0;
+	}
+	return 1;
+}
+
+void Metrics::stop(){
+	if(mThread==NULL) return;
+	mbStop = 1;
+	SDL_WaitThread(mThread, NULL);
+	mThread = NULL;
+	//Keep the final values
+	if(!msFile.empty()) writeFile();
+	if(miListener>=0){
+		Net::close(miListener);
+		miListener = -1;
+#ifndef _WIN32
+		::unlink(msAddress.c_str());
+#endif
+	}
+}
+
+int Metrics::serve(void*){
+	Uint32 nextWrite = 0;
+	string text;
+	while(!mbStop){
+		//Rewrite the file
+		if(!msFile.empty() && (Sint32)(SDL_GetTicks()-nextWrite)>=0){
+			writeFile();
+			nextWrite = SDL_GetTicks()+METRICS_INTERVAL;
+		}
+
+		//Wait for a scraper
+#ifndef _WIN32
+		if(miListener>=0){
+			pollfd p = {miListener, POLLIN, 0};
+			if(poll(&p, 1, SERVE_WAIT)<=0) continue;
+			//Answer every waiting connection with one snapshot
+			int fd;
+			while((fd = ::accept(miListener, NULL, NULL))>=0){
+				format(text);
+				size_t sent = 0;
+				while(sent<text.size()){
+					ssize_t n = ::send(fd, text.data()+sent, text.size()-sent, MSG_NOSIGNAL);
+					if(n<=0) break;
+					sent += n;
+				}
+				Net::close(fd);
+			}
+			continue;
+		}
+#endif
+		SDL_Delay(SERVE_WAIT);
+	}
+	return 0;
+}
+
+void Metrics::writeFile(){
+	string text, temp = msFile+".tmp";
+	format(text);
+	FILE* out = fopen(temp.c_str(), "w");
+	if(out==NULL){
+		cerr << "Metrics error: cannot write " << temp << endl;
+		return;
+	}
+	bool ok = fwrite(text.data(), 1, text.size(), out)==text.size();
+	if(fclose(out)!=0) ok = 0;
+	//rename() does not replace an existing file on Windows
+#ifdef _WIN32
+	::remove(msFile.c_str());
+#endif
+	if(!ok || rename(temp.c_str(), msFile.c_str())!=0) cerr << "Metrics error: cannot write " << msFile << endl;
+}
+
+
+
+
+void Metrics::format(string& out){
+	out.clear();
+	char buffer[160];
+
+	//Counters
+	for(int c = 0; c < METRIC_COUNTERS; ++c){
+		snprintf(buffer, sizeof(buffer), "# HELP %s %s\n# TYPE %s counter\n%s %llu\n", COUNTER_NAMES[c][0], COUNTER_NAMES[c][1],
+		         COUNTER_NAMES[c][0], COUNTER_NAMES[c][0], miCounters[c].load(std::memory_order_relaxed));
+		out += buffer;
+	}
+
+	//Histograms (buckets are cumulative in the text format)
+	for(int h = 0; h < METRIC_HISTOGRAMS; ++h){
+		const char* name = HISTOGRAM_NAMES[h][0];
+		Histogram& histogram = mHistograms[h];
+		snprintf(buffer, sizeof(buffer), "# HELP %s %s (ms)\n# TYPE %s histogram\n", name, HISTOGRAM_NAMES[h][1], name);
+		out += buffer;
+		unsigned long long total = 0;
+		for(int b = 0; b < METRIC_BUCKETS; ++b){
+			total += histogram.buckets[b].load(std::memory_order_relaxed);
+			if(b < METRIC_BUCKETS-1) snprintf(buffer, sizeof(buffer), "%s_bucket{le=\"%g\"} %llu\n", name, BUCKETS[b], total);
+			else snprintf(buffer, sizeof(buffer), "%s_bucket{le=\"+Inf\"} %llu\n", name, total);
+			out += buffer;
+		}
+		//Count matches the +Inf bucket even while other threads add values
+		snprintf(buffer, sizeof(buffer), "%s_sum %.3f\n%s_count %llu\n", name,
+		         histogram.sumUs.load(std::memory_order_relaxed)/1000.0, name, total);
+		out += buffer;
+	}
+
+	//Resident resources
+	out += "# HELP ludo_resource_bytes Resident resource size\n# TYPE ludo_resource_bytes gauge\n";
+	for(int k = 0; k < RESOURCE_KINDS; ++k){
+		snprintf(buffer, sizeof(buffer), "ludo_resource_bytes{kind=\"%s\"} %llu\n", RESOURCE_NAMES[k],
+		         (unsigned long long)Resources::bytes((ResourceKinds)k));
+		out += buffer;
+	}
+}
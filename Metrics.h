@@ -0,0 +1,86 @@
+///Runtime metrics for unattended installations (counters, histograms and resource sizes,
+///served as Prometheus text on a Unix socket and/or rewritten to a file by a background thread)
+
+#ifndef METRICS_H
+#define METRICS_H
+
+///Include SDL modules
+#include <SDL2/SDL.h>
+
+///Include local modules
+#include "Shared.h"
+
+///Misc library inclusion
+#include <atomic>
+#include <string>
+using std::string;
+
+///Counted events
+enum MetricCounters{METRIC_FRAMES, METRIC_TURNS, METRIC_SAVES, METRIC_UNDERRUNS, METRIC_COUNTERS};
+
+///Measured durations
+enum MetricHistograms{HISTOGRAM_FRAME, HISTOGRAM_SAVE, METRIC_HISTOGRAMS};
+
+///Histogram buckets (upper bounds in ms, the last bucket takes the rest)
+#define METRIC_BUCKETS 12
+
+class Metrics{
+public:
+
+	///Count an event (any thread, lock-free)
+	///Args:
+	///MetricCounters c - counter
+	static void count(MetricCounters c);
+
+	///Add a duration (any thread, lock-free)
+	///Args:
+	///MetricHistograms h - histogram
+	///double ms - duration (in ms)
+	static void observe(MetricHistograms h, double ms);
+
+	///Count a rendered frame and its duration since the previous call (render thread)
+	static void frame();
+
+	///Start serving metrics (returns 0 if the socket cannot be opened)
+	///Args:
+	///const string& address - Unix socket path (empty for none), every connection gets one snapshot
+	///const string& file - file rewritten every METRICS_INTERVAL ms (empty for none)
+	static bool start(const string& address, const string& file);
+
+	///Stop the serving thread, write the file a last time and remove the socket
+	static void stop();
+
+	///Write the current values in Prometheus text format
+	///Args:
+	///string& out - output text
+	static void format(string& out);
+
+private:
+
+	///Duration histogram
+	struct Histogram{
+		std::atomic<unsigned long long> buckets[METRIC_BUCKETS];
+		std::atomic<unsigned long long> sumUs;
+	};
+
+	///Values
+	static std::atomic<unsigned long long> miCounters[METRIC_COUNTERS];
+	static Histogram mHistograms[METRIC_HISTOGRAMS];
+
+	///Previous frame start (performance counter ticks, render thread only)
+	static Uint64 miLastFrame;
+
+	///Serving thread, its stop flag, listening socket and outputs
+	static SDL_Thread* mThread;
+	static std::atomic<bool> mbStop;
+	static int miListener;
+	static string msAddress, msFile;
+
+	///Serving thread body
+	static int serve(void*);
+
+	///Rewrite the metrics file (through a temporary file, so readers never see half of it)
+	static void writeFile();
+};
+
+#endif
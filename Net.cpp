@@ -0,0 +1,293 @@
+#include "Net.h"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+#endif
+#include <cstring>
+
+#ifndef _WIN32
+//Split "host:port" (host defaults to all interfaces / localhost)
+static addrinfo* resolve(const string& address, bool passive){
+	size_t colon = address.rfind(':');
+	string host = colon==string::npos ? "" : address.substr(0, colon);
+	string port = colon==string::npos ? address : address.substr(colon+1);
+	addrinfo hints, *result = NULL;
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	if(passive) hints.ai_flags = AI_PASSIVE;
+	int error = getaddrinfo(host.empty() ? NULL : host.c_str(), port.c_str(), &hints, &result);
+	if(error){
+		cerr << "Net error: " << address << ": " << gai_strerror(error) << endl;
+		return NULL;
+	}
+	return result;
+}
+
+//Fill a Unix socket address
+static bool unixAddress(const string& path, sockaddr_un& out){
+	memset(&out, 0, sizeof(out));
+	out.sun_family = AF_UNIX;
+	if(path.size()>=sizeof(out.sun_path)){
+		cerr << "Net error: socket path too long: " << path << endl;
+		return 0;
+	}
+	strcpy(out.sun_path, path.c_str());
+	return 1;
+}
+#endif
+
+
+
+
+int Net::listen(const string& address, bool reusePort){
+#ifndef _WIN32
+	int fd = -1;
+	//Unix socket
+	if(address.find('/')!=string::npos){
+		sockaddr_un addr;
+		if(!unixAddress(address, addr)) return -1;
+		::unlink(address.c_str());
+		fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+		if(fd>=0 && bind(fd, (sockaddr*)&addr, sizeof(addr))<0){ ::close(fd); fd = -1; }
+	}
+	//TCP
+	else {
+		addrinfo* result = resolve(address, 1);
+		for(addrinfo* a = result; a && fd<0; a = a->ai_next){
+			fd = socket(a->ai_family, a->ai_socktype | SOCK_CLOEXEC, a->ai_protocol);
+			if(fd<0) continue;
+			int on = 1;
+			setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+#ifdef SO_REUSEPORT
+			if(reusePort) setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on));
+#endif
+			if(bind(fd, a->ai_addr, a->ai_addrlen)<0){ ::close(fd); fd = -1; }
+		}
+		if(result) freeaddrinfo(result);
+	}
+	if(fd<0 || ::listen(fd, SOMAXCONN)<0 || !setNonBlocking(fd)){
+		cerr << "Net error: cannot listen on " << address << ": " << strerror(errno) << endl;
+		if(fd>=0) ::close(fd);
+		return -1;
+	}
+	return fd;
+#else
+	cerr << "Net error: sockets are not available on this platform" << endl;
+	return -1;
+#endif
+}
+
+int Net::connect(const string& address){
+#ifndef _WIN32
+	int fd = -1;
+	//Unix socket
+	if(address.find('/')!=string::npos){
+		sockaddr_un addr;
+		if(!unixAddress(address, addr)) return -1;
+		fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+		if(fd>=0 && ::connect(fd, (sockaddr*)&addr, sizeof(addr))<0){ ::close(fd); fd = -1; }
+	}
+	//TCP
+	else {
+		addrinfo* result = resolve(address, 0);
+		for(addrinfo* a = result; a && fd<0; a = a->ai_next){
+			fd = socket(a->ai_family, a->ai_socktype | SOCK_CLOEXEC, a->ai_protocol);
+			if(fd>=0 && ::connect(fd, a->ai_addr, a->ai_addrlen)<0){ ::close(fd); fd = -1; }
+		}
+		if(result) freeaddrinfo(result);
+	}
+	if(fd<0 || !setNonBlocking(fd)){
+		cerr << "Net error: cannot connect to " << address << ": " << strerror(errno) << endl;
+		if(fd>=0) ::close(fd);
+		return -1;
+	}
+	return fd;
+#else
+	cerr << "Net error: sockets are not available on this platform" << endl;
+	return -1;
+#endif
+}
+
+bool Net::setNonBlocking(int fd){
+#ifndef _WIN32
+	int flags = fcntl(fd, F_GETFL, 0);
+	return flags>=0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK)>=0;
+#else
+	return 0;
+#endif
+}
+
+void Net::close(int fd){
+#ifndef _WIN32
+	if(fd>=0) ::close(fd);
+#endif
+}
+
+
+
+
+Frame Net::frame(const Message& m){
+	shared_ptr<string> out = std::make_shared<string>();
+	Protocol::encode(m, *out);
+	return out;
+}
+
+
+
+
+//Constructor
+Connection::Connection(){
+	miFd = -1;
+	miSent = 0;
+	miQueued = 0;
+}
+
+//Destructor
+Connection::~Connection(){
+	close();
+}
+
+//Connect to server
+bool Connection::open(const string& address){
+	close();
+	miFd = Net::connect(address);
+	return miFd>=0;
+}
+
+//Take over socket
+void Connection::attach(int fd, const string& input){
+	close();
+	miFd = fd;
+	mIn = input;
+}
+
+//Give up socket
+int Connection::detach(){
+	int fd = miFd;
+	miFd = -1;
+	mIn.clear();
+	mOut.clear();
+	miSent = 0;
+	miQueued = 0;
+	return fd;
+}
+
+//Close socket
+void Connection::close(){
+	Net::close(detach());
+}
+
+//Getters
+bool Connection::isOpen() const {
+	return miFd>=0;
+}
+
+int Connection::getFd() const {
+	return miFd;
+}
+
+const string& Connection::getInput() const {
+	return mIn;
+}
+
+
+
+
+//Read available data
+bool Connection::receive(){
+#ifndef _WIN32
+	if(miFd<0) return 0;
+	char buffer[4096];
+	while(1){
+		ssize_t length = ::read(miFd, buffer, sizeof(buffer));
+		if(length>0) mIn.append(buffer, length);
+		else if(length==0) return 0;
+		else if(errno==EINTR) continue;
+		else return errno==EAGAIN || errno==EWOULDBLOCK;
+	}
+#else
+	return 0;
+#endif
+}
+
+//Take next message
+int Connection::next(Message& m){
+	int length = Protocol::decode(mIn.data(), mIn.size(), m);
+	if(length<=0) return length;
+	mIn.erase(0, length);
+	return 1;
+}
+
+//Queue message
+void Connection::send(const Message& m){
+	send(Net::frame(m));
+}
+
+//Queue shared frame
+void Connection::send(const Frame& f){
+	mOut.push_back(f);
+	miQueued += f->size();
+}
+
+//Write queued frames
+bool Connection::flush(){
+#ifndef _WIN32
+	while(miFd>=0 && !mOut.empty()){
+		//Point at the queued frames instead of joining them
+		iovec parts[64];
+		int count = 0;
+		for(deque<Frame>::iterator it = mOut.begin(); it!=mOut.end() && count < 64; ++it, ++count){
+			size_t skip = count ? 0 : miSent;
+			parts[count].iov_base = (void*)((*it)->data()+skip);
+			parts[count].iov_len = (*it)->size()-skip;
+		}
+		msghdr message;
+		memset(&message, 0, sizeof(message));
+		message.msg_iov = parts;
+		message.msg_iovlen = count;
+		ssize_t length = ::sendmsg(miFd, &message, MSG_NOSIGNAL);
+		if(length<0 && errno==EINTR) continue;
+		if(length<=0) return length<0 && (errno==EAGAIN || errno==EWOULDBLOCK);
+
+		//Release sent frames
+		miQueued -= length;
+		length += miSent;
+		while(!mOut.empty() && (size_t)length>=mOut.front()->size()){
+			length -= mOut.front()->size();
+			mOut.pop_front();
+		}
+		miSent = length;
+	}
+	return miFd>=0;
+#else
+	return 0;
+#endif
+}
+
+//Check for queued data
+bool Connection::hasOutput() const {
+	return !mOut.empty();
+}
+
+//Queued bytes
+size_t Connection::getQueued() const {
+	return miQueued;
+}
+
+//Drop unsent frames (a partly sent frame is finished to keep the stream intact)
+void Connection::discard(){
+	while(mOut.size() > (miSent ? 1 : 0)){
+		miQueued -= mOut.back()->size();
+		mOut.pop_back();
+	}
+}
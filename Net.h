@@ -0,0 +1,131 @@
+///Socket helpers and buffered message connections (POSIX sockets)
+
+#ifndef NET_H
+#define NET_H
+
+///Include local modules
+#include "Protocol.h"
+
+///Misc library inclusion
+#include <iostream>
+using std::cerr;
+using std::endl;
+#include <string>
+using std::string;
+#include <deque>
+using std::deque;
+#include <memory>
+using std::shared_ptr;
+
+///Encoded message shared by every connection it is sent to
+typedef shared_ptr<const string> Frame;
+
+///Socket helpers
+///Addresses are "host:port" (TCP) or a path containing '/' (Unix socket)
+class Net{
+public:
+
+	///Open a non-blocking listening socket (returns -1 on error)
+	///Args:
+	///const string& address - listening address
+	///bool reusePort - allow several listeners on one TCP port
+	static int listen(const string& address, bool reusePort = 0);
+
+	///Connect a socket (returns -1 on error)
+	///Args:
+	///const string& address - server address
+	static int connect(const string& address);
+
+	///Switch socket to non-blocking mode
+	static bool setNonBlocking(int fd);
+
+	///Close a socket
+	static void close(int fd);
+
+	///Encode a message once for any number of connections
+	///Args:
+	///const Message& m - message
+	static Frame frame(const Message& m);
+};
+
+///Buffered connection exchanging protocol messages
+class Connection{
+public:
+
+	///Constructor (closed connection)
+	Connection();
+
+	///Destructor (closes the socket)
+	~Connection();
+
+	///Connect to a server (the socket is non-blocking afterwards)
+	///Args:
+	///const string& address - server address
+	bool open(const string& address);
+
+	///Take over a connected non-blocking socket
+	///Args:
+	///int fd - socket
+	///const string& input - data already read from the socket
+	void attach(int fd, const string& input = "");
+
+	///Give up the socket without closing it (returns the socket)
+	int detach();
+
+	///Close the socket
+	void close();
+
+	///Getters
+	bool isOpen() const;
+	int getFd() const;
+	const string& getInput() const;
+
+	///Read available data (returns 0 once the peer has closed)
+	bool receive();
+
+	///Take the next complete message
+	///(returns 1 if one was received, 0 if none, -1 if the data is malformed)
+	///Args:
+	///Message& m - decoded message
+	int next(Message& m);
+
+	///Queue a message for sending
+	///Args:
+	///const Message& m - message
+	void send(const Message& m);
+
+	///Queue an encoded message without copying it
+	///Args:
+	///const Frame& f - shared encoded message
+	void send(const Frame& f);
+
+	///Write queued frames with one scatter-gather call (returns 0 on error)
+	bool flush();
+
+	///Check if queued data is waiting for the socket
+	bool hasOutput() const;
+
+	///Bytes waiting for the socket
+	size_t getQueued() const;
+
+	///Drop queued frames that have not started sending
+	void discard();
+
+private:
+
+	///Copying would close the socket twice
+	Connection(const Connection&);
+	Connection& operator=(const Connection&);
+
+	///Socket (-1 if closed)
+	int miFd;
+
+	///Received data
+	string mIn;
+
+	///Queued frames, bytes of the first one already sent, total queued bytes
+	deque<Frame> mOut;
+	size_t miSent, miQueued;
+};
+
+#endif
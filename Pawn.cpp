@@ -6,9 +6,17 @@
  */
 
 #include "Pawn.h"
+#include "Resources.h"
+
+vector<AnimationClip> Pawn::m_vClips;
 
 Pawn::Pawn(Colors c)
-		:mPlayerSprite(SDL_Rect {0,0,SPRITE_SIZE, SPRITE_SIZE}, PAWN_FRAMES, 20)
+{
+	m_bIdle = 1;
+	reset(c);
+}
+
+void Pawn::reset(Colors c)
 {
 	setEColor(c);
 	setIPosition(0);
@@ -16,14 +24,46 @@ Pawn::Pawn(Colors c)
 	setIYPosition(-1);
 	setDScale(1);
 	setBIdle(1);
-	mPlayerSprite.load(PAWN_PATH);
+}
+
+void Pawn::loadSheet()
+{
+	// load the sheet and make the clips only once
+	if (!m_vClips.empty())
+		return;
+	Resources::Scope scope("pawns");
+	getSheet().load(PAWN_PATH);
+	for (int color = 0; color < PLAYERS; color++)
+	{
+		for (int idle = 0; idle < 2; idle++)
+		{
+			SDL_Rect frame = { 0, color*SPRITE_SIZE*6+idle*3*SPRITE_SIZE, SPRITE_SIZE, SPRITE_SIZE };
+			m_vClips.push_back(AnimationClip(frame, PAWN_FRAMES, 20, getSheet().getWidth()));
+		}
+	}
 }
 
 // methods
 void Pawn::render(int x, int y)
 {
-	//Render sprite
-	mPlayerSprite.render(x, y, m_dScale);
+	// the sheet is loaded here if the game did not do it already
+	loadSheet();
+	// pick the frame from the shared clip
+	SDL_Rect frame = getClip().getFrame(m_iPhase);
+	getSheet().render(x, y, m_dScale, &frame);
+}
+
+const AnimationClip& Pawn::getClip() const
+{
+	int color = m_eColor > NONE ? m_eColor-1 : 0;
+	return m_vClips[color*2+m_bIdle];
+}
+
+Texture& Pawn::getSheet()
+{
+	// made on first use, so it is released before SDL quits
+	static Texture sheet;
+	return sheet;
 }
 
 // destructor
@@ -63,18 +103,16 @@ Colors Pawn::getEColor() const
 	return m_eColor;
 }
 
-void Pawn::setAnimationFrame()
+void Pawn::setAnimationPhase()
 {
-	//Initialize frame dimensions
-	SDL_Rect frame = { 0, (m_eColor-1)*SPRITE_SIZE*6+m_bIdle*3*SPRITE_SIZE, SPRITE_SIZE, SPRITE_SIZE };
-	//Set sprite animation frame
-	mPlayerSprite.setAnimationFrame(frame);
+	// idle pawns share one phase, walking starts from the first frame
+	m_iPhase = m_bIdle ? 0 : Clock::now();
 }
 
 void Pawn::setEColor(Colors eColor)
 {
 	m_eColor = eColor;
-	setAnimationFrame();
+	setAnimationPhase();
 }
 
 void Pawn::setIXPosition(int iXPosition)
@@ -96,5 +134,5 @@ void Pawn::setDScale(double dScale)
 void Pawn::setBIdle(bool bIdle)
 {
 	m_bIdle = bIdle;
-	setAnimationFrame();
+	setAnimationPhase();
 }
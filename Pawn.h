@@ -12,8 +12,9 @@
 #define ANIMATION_DELAY 25
 #define NUM_OF_FRAMES 20
 
-///Include sprite class
-#include "Sprite.h"
+///Include animation classes
+#include "Texture.h"
+#include "AnimationClip.h"
 #include "Shared.h"
 
 #include <iostream>
@@ -42,16 +43,36 @@ private:
 	// pawn color
 	Colors m_eColor;
 	
-	///Sprite object pointer
-	Sprite mPlayerSprite;
+	// start time of the current animation
+	Uint32 m_iPhase;
 
-	// method that set the right picture of the pawn
-	void setAnimationFrame();
+	// method that restarts the animation of the pawn
+	void setAnimationPhase();
+
+	// returns the clip for the color and state of the pawn
+	const AnimationClip& getClip() const;
+
+	// the spritesheet shared by all pawns
+	static Texture& getSheet();
+
+	// the walking and idle clips of every color
+	static vector<AnimationClip> m_vClips;
 
 public:
-	Pawn(Colors c);
+	///Constructor (pawns can be made before SDL starts, the sheet is loaded by loadSheet())
+	///Args:
+	///Colors c - pawn color (NONE for final square placeholders)
+	Pawn(Colors c = NONE);
 	virtual ~Pawn();
 
+	///Reset the pawn in place (not on the board, idle, full size)
+	///Args:
+	///Colors c - pawn color
+	void reset(Colors c);
+
+	///Load the shared spritesheet and clips (once, after the renderer is made)
+	static void loadSheet();
+
 	///Rendering method
 	///Args:
 	///int x - X screen coordinate
@@ -0,0 +1,108 @@
+///ludo-peer - headless lockstep peer playing random legal moves
+///Usage:
+///  ludo-peer --host ADDRESS [--seats N] [--seed S] [--desync TURN]
+///  ludo-peer --join ADDRESS [--seats N] [--seed S] [--desync TURN]
+
+#include "Lockstep.h"
+
+#include <csignal>
+#include <cstdlib>
+#include <ctime>
+
+using std::cout;
+
+int main(int argc, char* argv[]){
+	string hostAddress, joinAddress;
+	int seats = 1;
+	int desync = -1;
+	unsigned seed = time(0);
+
+	//Read command line options
+	for(int i = 1; i < argc; ++i){
+		string arg = argv[i];
+		if(arg=="--host" && i+1<argc) hostAddress = argv[++i];
+		else if(arg=="--join" && i+1<argc) joinAddress = argv[++i];
+		else if(arg=="--seats" && i+1<argc) seats = atoi(argv[++i]);
+		else if(arg=="--seed" && i+1<argc) seed = strtoul(argv[++i], NULL, 0);
+		else if(arg=="--desync" && i+1<argc) desync = atoi(argv[++i]);
+		else {
+			hostAddress = joinAddress = "";
+			break;
+		}
+	}
+	if(hostAddress.empty()==joinAddress.empty()){
+		cerr << "Usage: " << argv[0] << " --host ADDRESS [--seats N] [--seed S] [--desync TURN]" << endl
+		     << "       " << argv[0] << " --join ADDRESS [--seats N] [--seed S] [--desync TURN]" << endl;
+		return 1;
+	}
+	//Move choices only (dice come from all peers)
+	srand(seed);
+	signal(SIGPIPE, SIG_IGN);
+
+	Lockstep peer;
+	if(!(hostAddress.empty() ? peer.join(joinAddress, seats) : peer.host(hostAddress, seats))) return 1;
+
+	deque<Message> in;
+	//The first snapshot starts the match
+	int resyncs = -1;
+	//Turns already rolled and moved (the engine can be several messages ahead)
+	int rolled = -1, moved = -1;
+	bool acted = 0;
+	while(peer.isOpen()){
+		//Seats may take a while to fill, a started match may not stall
+		if(!acted && !peer.wait(peer.getEngine().getCurrent() ? 5000 : 60000)){
+			cerr << "Peer: timed out" << endl;
+			return 1;
+		}
+		peer.poll(in);
+		acted = 0;
+		while(!in.empty()){
+			Message m = in.front();
+			in.pop_front();
+			const Engine& e = peer.getEngine();
+			switch(m.type){
+				case MSG_SNAPSHOT:
+					resyncs++;
+					break;
+				case MSG_END:
+					cout << "Match finished after " << e.getTurn() << " turns, state " << std::hex << e.getHash() << std::dec
+					     << ", " << peer.getTraffic() << " bytes received (" << peer.getTraffic()/(e.getTurn()+1) << " per turn), "
+					     << resyncs << " resyncs" << endl;
+					peer.close();
+					return 0;
+				case MSG_LEFT:
+					return 1;
+				case MSG_ERROR:
+					cerr << "Peer: command refused: error " << m.value << endl;
+					return 1;
+				default:
+					break;
+			}
+		}
+
+		//Play the local seats
+		const Engine& e = peer.getEngine();
+		if(!e.getCurrent() || e.isOver() || !peer.isLocal(e.getCurrent())) continue;
+		if(!e.getRoll() && rolled!=e.getTurn()){
+			//Damage the local state to check that the host repairs it
+			if(desync>=0 && e.getTurn()>=desync){
+				vector<PlayerRecord> players = e.getPlayers();
+				players.back().steps++;
+				peer.load(players, e.getTurn(), e.getRoll());
+				desync = -1;
+			}
+			rolled = e.getTurn();
+			peer.send(Message(MSG_ROLL_REQUEST));
+			acted = 1;
+		}
+		vector<int> moves = e.getMoves();
+		if(e.getRoll() && moves.size()>1 && moved!=e.getTurn()){
+			moved = e.getTurn();
+			Message move(MSG_MOVE_REQUEST);
+			move.pawn = moves[rand()%moves.size()];
+			peer.send(move);
+			acted = 1;
+		}
+	}
+	return 1;
+}
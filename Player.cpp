@@ -1,29 +1,41 @@
 #include "Player.h"
 
 Player::Player(Colors color)
-		: m_iSteps(), m_iTaken(), m_iLost()
 {
+	// point the vector to the pawns once
+	for (unsigned int i = 0; i < PAWNS; i++)
+		m_vPawns.push_back(&m_aPawns[i]);
+	reset(color);
+}
+
+void Player::reset(Colors color)
+{
+	m_iSteps = 0;
+	m_iTaken = 0;
+	m_iLost = 0;
 	// set the active pawns to zero
 	setIActivePawns(0);
 	// put the dice with correct default value
-	setIDiceRoll(1);
+	m_iDiceRoll = 1;
 	// at the begging of the game no one is finished
 	setIFinishPosition(0);
-	// it set the color of the pawns and the player
-	setEColor(color);
-	// sets the pawns vector with empty values
-	SetPawnsVector();
+	// it set the color of the player
+	m_EColor = color;
+
+	for (unsigned int i = 0; i < PAWNS; i++)
+	{
+		m_aPawns[i].reset(color);
+		// set position into base
+		if (color != NONE)
+		{
+			m_aPawns[i].setIXPosition(BASE_SQUARES[color - 1][i].first);
+			m_aPawns[i].setIYPosition(BASE_SQUARES[color - 1][i].second);
+		}
+	}
 }
 
 Player::~Player()
 {
-	while(m_vPawns.size()>0)
-	{
-		// delete all the pawns in the vector
-		// the vector is made with dynamically allocated memory
-		delete m_vPawns.back();
-		m_vPawns.pop_back();
-	}
 }
 
 template<typename Key, typename Value>
@@ -198,21 +210,3 @@ void Player::setEColor(Colors eColor)
 	}
 
 }
-
-void Player::SetPawnsVector()
-{
-	for (unsigned int i = 0; i < PAWNS; i++)
-	{
-		//make a dynamic allocated pawn
-		Pawn* pawn = new Pawn(m_EColor);
-
-		// give it to the vector
-		m_vPawns.push_back(pawn);
-
-		// set position into base
-		m_vPawns.back()->setIXPosition(
-				BASE_SQUARES[m_EColor - 1][i].first);
-		m_vPawns.back()->setIYPosition(
-				BASE_SQUARES[m_EColor - 1][i].second);
-	}
-}
@@ -40,18 +40,28 @@ private:
 	/// at what position the player finished the game
 	int m_iFinishPosition;
 
-	/// private method which helps to fill
-	/// the vector of the pawns with the necessary info
-	void SetPawnsVector();
+	/// the pawns of the player, kept inside the player
+	/// so a restart does not allocate them again
+	Pawn m_aPawns[PAWNS];
+
+	/// copies would point to the pawns of the original
+	Player(const Player&);
+	Player& operator=(const Player&);
 
 public:
 	///Constructor - wants the color of the player as an argument
-	Player(Colors color);
+	/// (NONE for an unused slot of the player pool)
+	Player(Colors color = NONE);
 
-	///Vector of player pawn pointers
+	///Vector of player pawn pointers (points into m_aPawns, set once)
 	/// its public so it can be used more efficiently and easy
 	vector<Pawn*> m_vPawns;
 
+	///Reset the player in place for a new game (statistics cleared, pawns in base)
+	///Args:
+	///Colors color - player color
+	void reset(Colors color);
+
 	/// methods
 	/// print all the info for the player
 	void Print();
@@ -0,0 +1,146 @@
+#include "Profiler.h"
+#include "Resources.h"
+
+#include <algorithm>
+#include <cstdio>
+
+vector<Profiler::FrameRecord> Profiler::mFrames;
+int Profiler::miNext = 0;
+int Profiler::miFilled = 0;
+Profiler::FrameRecord Profiler::mCurrent = Profiler::FrameRecord();
+Uint64 Profiler::miFrameStart = 0;
+Uint64 Profiler::miPhaseStart[PHASES];
+bool Profiler::mbVisible = 0;
+Texture Profiler::mLines[PHASES+COUNTERS+1];
+Uint32 Profiler::miRefreshed = 0;
+
+//Overlay line names
+static const char* PHASE_NAMES[PHASES] = {"events", "turn", "background", "sprites", "ui", "present", "recovery"};
+static const char* COUNTER_NAMES[COUNTERS] = {"draws", "uploads", "text"};
+
+//Overlay layout (graph height covers 50 ms)
+#define OVERLAY_X 10
+#define OVERLAY_Y 10
+#define OVERLAY_WIDTH 330
+#define GRAPH_HEIGHT 80
+#define GRAPH_MS 50.0
+
+void Profiler::frame(){
+	//Measuring always runs so the overlay has history as soon as it is shown
+	Uint64 now = SDL_GetPerformanceCounter();
+	if(miFrameStart){
+		//Resize the ring buffer (PROFILER_FRAMES may be reloaded)
+		unsigned size = std::max(PROFILER_FRAMES, 1);
+		if(mFrames.size()!=size){
+			mFrames.assign(size, FrameRecord());
+			miNext = miFilled = 0;
+		}
+		mCurrent.total = now-miFrameStart;
+		mFrames[miNext] = mCurrent;
+		miNext = (miNext+1)%size;
+		if(miFilled<(int)size) miFilled++;
+	}
+	miFrameStart = now;
+	mCurrent = FrameRecord();
+}
+
+void Profiler::begin(Phases p){
+	miPhaseStart[p] = SDL_GetPerformanceCounter();
+}
+
+void Profiler::end(Phases p){
+	mCurrent.phases[p] += SDL_GetPerformanceCounter()-miPhaseStart[p];
+}
+
+void Profiler::count(Counters c){
+	mCurrent.counts[c]++;
+}
+
+void Profiler::toggle(){
+	mbVisible = !mbVisible;
+	//Redraw text right away
+	miRefreshed = 0;
+}
+
+
+
+
+//Render overlay
+void Profiler::render(TTF_Font* f){
+	if(!mbVisible) return;
+	//Keep overlay draws and uploads out of the counters
+	int counted[COUNTERS];
+	for(int c = 0; c < COUNTERS; ++c) counted[c] = mCurrent.counts[c];
+
+	//Redraw text a few times per second (text uploads are slow)
+	if(!miRefreshed || SDL_GetTicks()-miRefreshed>=(Uint32)PROFILER_REFRESH) refresh(f);
+
+	//Panel
+	SDL_Renderer* r = Texture::mRenderer;
+	int lineHeight = mLines[0].getHeight();
+	SDL_Rect panel = {OVERLAY_X, OVERLAY_Y, OVERLAY_WIDTH, GRAPH_HEIGHT+(PHASES+COUNTERS+1)*lineHeight+30};
+	SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+	SDL_SetRenderDrawColor(r, 0, 0, 0, 180);
+	SDL_RenderFillRect(r, &panel);
+
+	//Frame time graph (oldest frame on the left)
+	int graphX = OVERLAY_X+10, graphBottom = OVERLAY_Y+10+GRAPH_HEIGHT, graphWidth = OVERLAY_WIDTH-20;
+	double msPerTick = 1000.0/SDL_GetPerformanceFrequency();
+	int size = mFrames.size();
+	for(int i = 0; i < miFilled; ++i){
+		double ms = mFrames[(miNext-miFilled+i+size)%size].total*msPerTick;
+		int height = std::min(ms/GRAPH_MS, 1.0)*GRAPH_HEIGHT;
+		int x = graphX+i*graphWidth/size;
+		//Green within 60 FPS, yellow within 30 FPS, red below
+		if(ms<=1000.0/60) SDL_SetRenderDrawColor(r, 80, 220, 80, 255);
+		else if(ms<=1000.0/30) SDL_SetRenderDrawColor(r, 230, 210, 60, 255);
+		else SDL_SetRenderDrawColor(r, 230, 70, 60, 255);
+		SDL_RenderDrawLine(r, x, graphBottom, x, graphBottom-height);
+	}
+	//60 FPS budget line
+	int budget = graphBottom-(1000.0/60)/GRAPH_MS*GRAPH_HEIGHT;
+	SDL_SetRenderDrawColor(r, 255, 255, 255, 120);
+	SDL_RenderDrawLine(r, graphX, budget, graphX+graphWidth, budget);
+
+	//Text lines
+	for(int i = 0; i < PHASES+COUNTERS+1; ++i)
+		mLines[i].render(graphX, graphBottom+10+i*lineHeight);
+
+	for(int c = 0; c < COUNTERS; ++c) mCurrent.counts[c] = counted[c];
+}
+
+//Redraw text lines
+void Profiler::refresh(TTF_Font* f){
+	miRefreshed = std::max(SDL_GetTicks(), (Uint32)1);
+	Resources::Scope scope("profiler");
+	double msPerTick = 1000.0/SDL_GetPerformanceFrequency();
+	int size = mFrames.size();
+	vector<double> values(miFilled);
+	char header[64];
+	snprintf(header, sizeof(header), "frame ms (%d)", miFilled);
+
+	for(int i = 0; i < miFilled; ++i) values[i] = mFrames[(miNext-miFilled+i+size)%size].total*msPerTick;
+	mLines[0].textLoad(percentiles(header, values), f, C_WHITE);
+	for(int p = 0; p < PHASES; ++p){
+		for(int i = 0; i < miFilled; ++i) values[i] = mFrames[(miNext-miFilled+i+size)%size].phases[p]*msPerTick;
+		mLines[1+p].textLoad(percentiles(PHASE_NAMES[p], values), f, C_WHITE);
+	}
+	for(int c = 0; c < COUNTERS; ++c){
+		for(int i = 0; i < miFilled; ++i) values[i] = mFrames[(miNext-miFilled+i+size)%size].counts[c];
+		mLines[1+PHASES+c].textLoad(percentiles(COUNTER_NAMES[c], values), f, C_WHITE);
+	}
+}
+
+//Format percentiles
+string Profiler::percentiles(string name, vector<double>& values){
+	double p[3] = {0, 0, 0};
+	const double ranks[3] = {0.5, 0.95, 0.99};
+	for(int i = 0; i < 3 && !values.empty(); ++i){
+		vector<double>::iterator nth = values.begin()+std::min<size_t>(ranks[i]*values.size(), values.size()-1);
+		std::nth_element(values.begin(), nth, values.end());
+		p[i] = *nth;
+	}
+	char line[96];
+	snprintf(line, sizeof(line), "%-14s %6.3g %6.3g %6.3g", name.c_str(), p[0], p[1], p[2]);
+	return line;
+}
@@ -0,0 +1,91 @@
+///Frame profiler (main loop phase timings and render counters of the last PROFILER_FRAMES frames)
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+///Include SDL modules
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+///Include local modules
+#include "Shared.h"
+#include "Texture.h"
+
+///Misc library inclusion
+#include <vector>
+using std::vector;
+
+///Timed main loop phases (recovery saves are also part of the turn)
+enum Phases{PHASE_EVENTS, PHASE_TURN, PHASE_BACKGROUND, PHASE_SPRITES, PHASE_UI, PHASE_PRESENT, PHASE_RECOVERY, PHASES};
+
+///Counted render calls
+enum Counters{COUNT_DRAWS, COUNT_UPLOADS, COUNT_TEXT, COUNTERS};
+
+class Profiler{
+public:
+
+	///Close the last frame and start a new one
+	static void frame();
+
+	///Start timing a phase
+	///Args:
+	///Phases p - main loop phase
+	static void begin(Phases p);
+
+	///Stop timing a phase (time adds up if a phase runs several times a frame)
+	///Args:
+	///Phases p - main loop phase
+	static void end(Phases p);
+
+	///Count a render call
+	///Args:
+	///Counters c - counter
+	static void count(Counters c);
+
+	///Show or hide the overlay
+	static void toggle();
+
+	///Render the overlay if it is shown (its own render calls are not counted)
+	///Args:
+	///TTF_Font* f - overlay font
+	static void render(TTF_Font* f);
+
+private:
+
+	///Measurements of one frame (times in performance counter ticks)
+	struct FrameRecord{
+		Uint64 total;
+		Uint64 phases[PHASES];
+		int counts[COUNTERS];
+	};
+
+	///Frame ring buffer, next slot and filled slots
+	static vector<FrameRecord> mFrames;
+	static int miNext, miFilled;
+
+	///Running frame
+	static FrameRecord mCurrent;
+
+	///Start of the running frame and phases
+	static Uint64 miFrameStart, miPhaseStart[PHASES];
+
+	///Overlay flag
+	static bool mbVisible;
+
+	///Overlay text lines (redrawn every PROFILER_REFRESH ms)
+	static Texture mLines[PHASES+COUNTERS+1];
+	static Uint32 miRefreshed;
+
+	///Redraw the overlay text lines
+	///Args:
+	///TTF_Font* f - overlay font
+	static void refresh(TTF_Font* f);
+
+	///Format the 50th, 95th and 99th percentile of values as a text line
+	///Args:
+	///string name - line name
+	///vector<double>& values - measured values (reordered)
+	static string percentiles(string name, vector<double>& values);
+};
+
+#endif
@@ -0,0 +1,237 @@
+///protobench - protocol round-trip fuzzing and encode/decode benchmark
+///Usage: protobench [ITERATIONS] [SEED]
+
+#include "Protocol.h"
+#include "Engine.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+//Fuzzing RNG
+static std::minstd_rand gRandom;
+
+//Random number below n
+static int below(int n){
+	return gRandom()%n;
+}
+
+//Random pawn state
+static PawnRecord randomPawn(){
+	PawnRecord pawn = {below(BOARD_LENGTH+11), below(BOARD_WIDTH), below(BOARD_HEIGHT)};
+	return pawn;
+}
+
+//Random valid message of a type
+static Message randomMessage(MessageType type){
+	Message m(type);
+	switch(type){
+		case MSG_HELLO: m.value = PROTOCOL_VERSION; break;
+		case MSG_JOIN:
+		case MSG_WATCH: m.value = gRandom(); break;
+		case MSG_MOVE_REQUEST: m.pawn = below(PAWNS+1)-1; break;
+		case MSG_RESYNC: m.seq = gRandom(); break;
+		case MSG_SEAT: m.color = Colors(1+below(PLAYERS)); break;
+		case MSG_LEFT: m.color = Colors(below(PLAYERS+1)); break;
+		case MSG_ERROR: m.value = below(256); break;
+		case MSG_SNAPSHOT:
+			m.seq = gRandom();
+			m.turn = below(65536);
+			m.roll = below(7);
+			for(int i = below(PLAYERS+1); i > 0; --i){
+				PlayerRecord p = {Colors(1+below(PLAYERS)), below(65536), below(256), below(256),
+				                  below(PAWNS+1), below(PLAYERS+1), below(7), vector<PawnRecord>()};
+				for(int j = 0; j < PAWNS; ++j) p.pawns.push_back(randomPawn());
+				m.players.push_back(p);
+			}
+			break;
+		case MSG_TURN: m.seq = gRandom(); m.color = Colors(1+below(PLAYERS)); break;
+		case MSG_ROLL: m.seq = gRandom(); m.color = Colors(1+below(PLAYERS)); m.value = 1+below(6); break;
+		case MSG_MOVE:
+		case MSG_CAPTURE:
+			m.seq = gRandom();
+			m.color = Colors(1+below(PLAYERS));
+			m.pawn = type==MSG_MOVE ? below(PAWNS+1)-1 : below(PAWNS);
+			m.state = randomPawn();
+			if(type==MSG_CAPTURE) m.state.position = 0;
+			break;
+		case MSG_END:
+			m.seq = gRandom();
+			for(int i = below(PLAYERS+1); i > 0; --i) m.order.push_back(Colors(1+below(PLAYERS)));
+			break;
+		case MSG_TICK:
+			m.seq = gRandom();
+			m.color = Colors(1+below(PLAYERS));
+			m.value = gRandom();
+			m.commit = gRandom();
+			m.hash = gRandom();
+			break;
+		case MSG_CHOICE:
+			m.seq = gRandom();
+			m.color = Colors(1+below(PLAYERS));
+			m.pawn = below(PAWNS+1)-1;
+			break;
+		default:
+			break;
+	}
+	return m;
+}
+
+//Field by field comparison
+static bool same(const Message& a, const Message& b){
+	if(a.type!=b.type || a.seq!=b.seq || a.value!=b.value || a.color!=b.color || a.pawn!=b.pawn) return 0;
+	if(a.commit!=b.commit || a.hash!=b.hash) return 0;
+	if(a.state.position!=b.state.position || a.state.x!=b.state.x || a.state.y!=b.state.y) return 0;
+	if(a.order!=b.order || a.turn!=b.turn || a.roll!=b.roll || a.players.size()!=b.players.size()) return 0;
+	for(unsigned i = 0; i < a.players.size(); ++i){
+		const PlayerRecord& p = a.players[i];
+		const PlayerRecord& q = b.players[i];
+		if(p.color!=q.color || p.steps!=q.steps || p.taken!=q.taken || p.lost!=q.lost || p.active!=q.active
+		   || p.finished!=q.finished || p.diceRoll!=q.diceRoll || p.pawns.size()!=q.pawns.size()) return 0;
+		for(unsigned j = 0; j < p.pawns.size(); ++j)
+			if(p.pawns[j].position!=q.pawns[j].position || p.pawns[j].x!=q.pawns[j].x || p.pawns[j].y!=q.pawns[j].y)
+				return 0;
+	}
+	return 1;
+}
+
+
+
+
+//Encode and decode random messages, whole, split and mutated
+static int fuzz(int iterations){
+	int errors = 0;
+	for(int i = 0; i < iterations; ++i){
+		//Stream of random messages
+		vector<Message> sent;
+		string stream;
+		for(int j = 1+below(8); j > 0; --j){
+			sent.push_back(randomMessage(MessageType(1+below(MSG_TYPES-1))));
+			size_t before = stream.size();
+			Protocol::encode(sent.back(), stream);
+			int fixed = Protocol::size(sent.back().type);
+			if(fixed>=0 && fixed!=int(stream.size()-before)){
+				cerr << "Size mismatch for type " << sent.back().type << endl;
+				errors++;
+			}
+		}
+
+		//Decode with the stream delivered in random pieces
+		string received;
+		size_t delivered = 0;
+		unsigned decoded = 0;
+		while(decoded < sent.size()){
+			if(delivered<stream.size()){
+				size_t piece = 1+below(stream.size()-delivered);
+				received.append(stream, delivered, piece);
+				delivered += piece;
+			}
+			Message m;
+			int length = Protocol::decode(received.data(), received.size(), m);
+			if(length<0 || (length==0 && delivered==stream.size())){
+				cerr << "Cannot decode message of type " << sent[decoded].type << endl;
+				errors++;
+				break;
+			}
+			if(length==0) continue;
+			if(!same(m, sent[decoded])){
+				cerr << "Round trip changed message of type " << m.type << endl;
+				errors++;
+			}
+			received.erase(0, length);
+			decoded++;
+		}
+
+		//Mutated and truncated data must be refused or decode to a message in range
+		string mutated = stream;
+		for(int j = 1+below(4); j > 0; --j) mutated[below(mutated.size())] = char(gRandom());
+		mutated.resize(below(mutated.size()+1));
+		const char* p = mutated.data();
+		size_t left = mutated.size();
+		Message m;
+		int length;
+		while((length = Protocol::decode(p, left, m))>0){
+			if(size_t(length)>left || m.color>PLAYERS || m.pawn<PASS || m.pawn>=PAWNS
+			   || m.state.x>=BOARD_WIDTH || m.state.y>=BOARD_HEIGHT){
+				cerr << "Mutated data decoded out of range" << endl;
+				errors++;
+				break;
+			}
+			p += length;
+			left -= length;
+		}
+	}
+	return errors;
+}
+
+
+
+
+//Encode / decode throughput
+static void benchmark(int iterations){
+	vector<Message> messages;
+	for(int i = 0; i < 1024; ++i) messages.push_back(randomMessage(MessageType(MSG_TURN+below(4))));
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	string stream;
+	size_t count = 0, bytes = 0;
+	for(int i = 0; i < iterations; ++i){
+		stream.clear();
+		for(unsigned j = 0; j < messages.size(); ++j) Protocol::encode(messages[j], stream);
+		Message m;
+		for(size_t at = 0; at < stream.size(); )
+			at += Protocol::decode(stream.data()+at, stream.size()-at, m);
+		count += messages.size();
+		bytes += stream.size();
+	}
+	double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now()-start).count();
+	cout << "Encode + decode: " << ns/count << " ns per message, " << bytes*1e3/ns << " MB/s" << endl;
+}
+
+//Traffic of played games (the deltas the server sends)
+static void traffic(int games){
+	size_t turns = 0, bytes = 0;
+	Message snapshot(MSG_SNAPSHOT);
+	for(int g = 0; g < games; ++g){
+		Engine engine;
+		engine.newGame(g);
+		if(!g){
+			snapshot.players = engine.getPlayers();
+			string out;
+			Protocol::encode(snapshot, out);
+			cout << "Snapshot: " << out.size() << " bytes" << endl;
+		}
+		while(!engine.isOver()){
+			engine.roll();
+			vector<int> moves = engine.getMoves();
+			vector<PlayerRecord> before = engine.getPlayers();
+			engine.move(moves.empty() ? PASS : moves[below(moves.size())]);
+			bytes += Protocol::size(MSG_ROLL)+Protocol::size(MSG_MOVE)+Protocol::size(MSG_TURN);
+			//Captures
+			for(unsigned i = 0; i < before.size(); ++i)
+				for(unsigned k = 0; k < engine.getPlayers().size(); ++k)
+					if(engine.getPlayers()[k].color==before[i].color)
+						bytes += Protocol::size(MSG_CAPTURE)*(engine.getPlayers()[k].lost-before[i].lost);
+			turns++;
+		}
+	}
+	cout << "Traffic: " << double(bytes)/turns << " bytes per move over " << turns << " moves" << endl;
+}
+
+
+
+
+int main(int argc, char* argv[]){
+	int iterations = argc > 1 ? atoi(argv[1]) : 100000;
+	gRandom.seed(argc > 2 ? strtoul(argv[2], NULL, 0) : 1);
+
+	int errors = fuzz(iterations);
+	cout << "Fuzz: " << iterations << " streams, " << errors << " errors" << endl;
+	benchmark(iterations/100+1);
+	traffic(100);
+	return errors ? 1 : 0;
+}
@@ -0,0 +1,363 @@
+#include "Protocol.h"
+
+//Squares are packed as x<<4 | y
+static_assert(BOARD_WIDTH<=16 && BOARD_HEIGHT<=16, "board squares do not fit in a byte");
+
+//Payload sizes of fixed-layout messages (-1 for variable sizes)
+static const int PAYLOAD[MSG_TYPES] = {
+	-1, //NONE
+	6,  //HELLO
+	4,  //JOIN
+	0,  //ROLL_REQUEST
+	1,  //MOVE_REQUEST
+	4,  //RESYNC
+	1,  //SEAT
+	-1, //SNAPSHOT
+	5,  //TURN
+	6,  //ROLL
+	8,  //MOVE
+	7,  //CAPTURE
+	-1, //END
+	1,  //LEFT
+	1,  //ERROR
+	4,  //WATCH
+	17, //TICK
+	6   //CHOICE
+};
+
+
+
+
+//Constructor
+Message::Message(MessageType type){
+	this->type = type;
+	seq = 0;
+	value = 0;
+	color = NONE;
+	pawn = 0;
+	state.position = 0;
+	state.x = 0;
+	state.y = 0;
+	turn = 0;
+	roll = 0;
+	commit = 0;
+	hash = 0;
+}
+
+
+
+
+//Little-endian writers
+static void put8(string& out, unsigned v){
+	out += char(v & 0xff);
+}
+
+static void put16(string& out, unsigned v){
+	put8(out, v);
+	put8(out, v>>8);
+}
+
+static void put32(string& out, unsigned v){
+	put16(out, v);
+	put16(out, v>>16);
+}
+
+static void putSquare(string& out, int x, int y){
+	put8(out, x<<4 | y);
+}
+
+//Bounds-checked little-endian reader
+struct Reader{
+	const unsigned char* p;
+	const unsigned char* end;
+	bool ok;
+
+	unsigned get8(){
+		if(p>=end){ ok = 0; return 0; }
+		return *p++;
+	}
+	unsigned get16(){
+		unsigned v = get8();
+		return v | get8()<<8;
+	}
+	unsigned get32(){
+		unsigned v = get16();
+		return v | get16()<<16;
+	}
+	Colors getColor(bool none){
+		unsigned c = get8();
+		if(c<=PLAYERS && (c!=NONE || none)) return Colors(c);
+		ok = 0;
+		return NONE;
+	}
+	int getPawn(bool pass){
+		int pawn = (signed char)get8();
+		if(pawn>=PAWNS || pawn<(pass ? PASS : 0)) ok = 0;
+		return pawn;
+	}
+	void getSquare(PawnRecord& pawn){
+		unsigned square = get8();
+		pawn.x = square>>4;
+		pawn.y = square & 0xf;
+		if(pawn.x>=BOARD_WIDTH || pawn.y>=BOARD_HEIGHT) ok = 0;
+	}
+};
+
+
+
+
+void Protocol::encode(const Message& m, string& out){
+	//Header (payload length is filled in below)
+	size_t start = out.size();
+	put8(out, m.type);
+	put8(out, 0);
+
+	switch(m.type){
+		case MSG_HELLO:
+			put32(out, PROTOCOL_MAGIC);
+			put16(out, m.value);
+			break;
+		case MSG_JOIN:
+		case MSG_WATCH:
+		case MSG_RESYNC:
+			put32(out, m.type==MSG_RESYNC ? m.seq : m.value);
+			break;
+		case MSG_MOVE_REQUEST:
+			put8(out, m.pawn);
+			break;
+		case MSG_SEAT:
+		case MSG_LEFT:
+			put8(out, m.color);
+			break;
+		case MSG_ERROR:
+			put8(out, m.value);
+			break;
+		case MSG_SNAPSHOT:
+			put32(out, m.seq);
+			put16(out, m.turn);
+			put8(out, m.roll);
+			put8(out, m.players.size());
+			for(unsigned i = 0; i < m.players.size(); ++i){
+				const PlayerRecord& p = m.players[i];
+				put8(out, p.color);
+				put16(out, p.steps);
+				put8(out, p.taken);
+				put8(out, p.lost);
+				put8(out, p.active);
+				put8(out, p.finished);
+				put8(out, p.diceRoll);
+				put8(out, p.pawns.size());
+				for(unsigned j = 0; j < p.pawns.size(); ++j){
+					put8(out, p.pawns[j].position);
+					putSquare(out, p.pawns[j].x, p.pawns[j].y);
+				}
+			}
+			break;
+		case MSG_TURN:
+			put32(out, m.seq);
+			put8(out, m.color);
+			break;
+		case MSG_ROLL:
+			put32(out, m.seq);
+			put8(out, m.color);
+			put8(out, m.value);
+			break;
+		case MSG_MOVE:
+		case MSG_CAPTURE:
+			put32(out, m.seq);
+			put8(out, m.color);
+			put8(out, m.pawn);
+			if(m.type==MSG_MOVE) put8(out, m.state.position);
+			putSquare(out, m.state.x, m.state.y);
+			break;
+		case MSG_END:
+			put32(out, m.seq);
+			put8(out, m.order.size());
+			for(unsigned i = 0; i < m.order.size(); ++i)
+				put8(out, m.order[i]);
+			break;
+		case MSG_TICK:
+			put32(out, m.seq);
+			put8(out, m.color);
+			put32(out, m.value);
+			put32(out, m.commit);
+			put32(out, m.hash);
+			break;
+		case MSG_CHOICE:
+			put32(out, m.seq);
+			put8(out, m.color);
+			put8(out, m.pawn);
+			break;
+		default:
+			break;
+	}
+	out[start+1] = char(out.size()-start-FRAME_HEADER);
+}
+
+
+
+
+int Protocol::decode(const char* data, size_t size, Message& m){
+	if(size<FRAME_HEADER) return 0;
+	unsigned type = (unsigned char)data[0];
+	unsigned length = (unsigned char)data[1];
+	if(type==MSG_NONE || type>=MSG_TYPES || (PAYLOAD[type]>=0 && length!=(unsigned)PAYLOAD[type])) return -1;
+	if(size<FRAME_HEADER+length) return 0;
+
+	m = Message(MessageType(type));
+	Reader in = {(const unsigned char*)data+FRAME_HEADER, (const unsigned char*)data+FRAME_HEADER+length, 1};
+	switch(type){
+		case MSG_HELLO:
+			if(in.get32()!=PROTOCOL_MAGIC) return -1;
+			m.value = in.get16();
+			break;
+		case MSG_JOIN:
+		case MSG_WATCH:
+			m.value = in.get32();
+			break;
+		case MSG_RESYNC:
+			m.seq = in.get32();
+			break;
+		case MSG_MOVE_REQUEST:
+			m.pawn = in.getPawn(1);
+			break;
+		case MSG_SEAT:
+		case MSG_LEFT:
+			m.color = in.getColor(type==MSG_LEFT);
+			break;
+		case MSG_ERROR:
+			m.value = in.get8();
+			break;
+		case MSG_SNAPSHOT: {
+			m.seq = in.get32();
+			m.turn = in.get16();
+			m.roll = in.get8();
+			unsigned players = in.get8();
+			if(players>PLAYERS || m.roll>6) return -1;
+			for(unsigned i = 0; i < players && in.ok; ++i){
+				PlayerRecord p;
+				p.color = in.getColor(0);
+				p.steps = in.get16();
+				p.taken = in.get8();
+				p.lost = in.get8();
+				p.active = in.get8();
+				p.finished = in.get8();
+				p.diceRoll = in.get8();
+				unsigned pawns = in.get8();
+				if(pawns!=PAWNS || p.active>PAWNS || p.finished>PLAYERS || p.diceRoll>6) return -1;
+				for(unsigned j = 0; j < pawns && in.ok; ++j){
+					PawnRecord pawn;
+					pawn.position = in.get8();
+					in.getSquare(pawn);
+					if(pawn.position>BOARD_LENGTH+10) return -1;
+					p.pawns.push_back(pawn);
+				}
+				m.players.push_back(p);
+			}
+			break;
+		}
+		case MSG_TURN:
+			m.seq = in.get32();
+			m.color = in.getColor(0);
+			break;
+		case MSG_ROLL:
+			m.seq = in.get32();
+			m.color = in.getColor(0);
+			m.value = in.get8();
+			if(m.value<1 || m.value>6) return -1;
+			break;
+		case MSG_MOVE:
+		case MSG_CAPTURE:
+			m.seq = in.get32();
+			m.color = in.getColor(0);
+			m.pawn = in.getPawn(type==MSG_MOVE);
+			if(type==MSG_MOVE) m.state.position = in.get8();
+			in.getSquare(m.state);
+			if(m.state.position>BOARD_LENGTH+10) return -1;
+			break;
+		case MSG_END: {
+			m.seq = in.get32();
+			unsigned count = in.get8();
+			if(count>PLAYERS) return -1;
+			for(unsigned i = 0; i < count && in.ok; ++i)
+				m.order.push_back(in.getColor(0));
+			break;
+		}
+		case MSG_TICK:
+			m.seq = in.get32();
+			m.color = in.getColor(0);
+			m.value = in.get32();
+			m.commit = in.get32();
+			m.hash = in.get32();
+			break;
+		case MSG_CHOICE:
+			m.seq = in.get32();
+			m.color = in.getColor(0);
+			m.pawn = in.getPawn(1);
+			break;
+		default:
+			break;
+	}
+	//Payload must be used exactly
+	if(!in.ok || in.p!=in.end) return -1;
+	return FRAME_HEADER+length;
+}
+
+int Protocol::size(MessageType type){
+	if(type<=MSG_NONE || type>=MSG_TYPES || PAYLOAD[type]<0) return -1;
+	return FRAME_HEADER+PAYLOAD[type];
+}
+
+
+
+
+bool Protocol::play(Engine& engine, int pawn, unsigned& seq, vector<Message>& out){
+	Colors c = engine.getCurrent();
+	vector<PlayerRecord> before = engine.getPlayers();
+	if(!engine.move(pawn)) return 0;
+	const vector<PlayerRecord>& after = engine.getPlayers();
+
+	//Moved pawn
+	Message moved(MSG_MOVE);
+	moved.seq = ++seq;
+	moved.color = c;
+	moved.pawn = pawn;
+	for(unsigned i = 0; i < after.size(); ++i)
+		if(after[i].color==c && pawn!=PASS) moved.state = after[i].pawns[pawn];
+	out.push_back(moved);
+
+	//Pawns sent back to base
+	for(unsigned i = 0; i < after.size(); ++i){
+		for(unsigned k = 0; k < before.size(); ++k){
+			if(before[k].color!=after[i].color || after[i].color==c) continue;
+			for(unsigned j = 0; j < after[i].pawns.size(); ++j){
+				if(before[k].pawns[j].position==0 || after[i].pawns[j].position!=0) continue;
+				Message captured(MSG_CAPTURE);
+				captured.seq = ++seq;
+				captured.color = after[i].color;
+				captured.pawn = j;
+				captured.state = after[i].pawns[j];
+				out.push_back(captured);
+			}
+		}
+	}
+
+	//If match is over
+	if(engine.isOver()){
+		Message end(MSG_END);
+		end.seq = ++seq;
+		for(int place = 1; place <= PLAYERS; ++place)
+			for(unsigned i = 0; i < after.size(); ++i)
+				if(after[i].finished==place || (place==PLAYERS && !after[i].finished))
+					end.order.push_back(after[i].color);
+		out.push_back(end);
+	}
+	//Next turn
+	else {
+		Message turn(MSG_TURN);
+		turn.seq = ++seq;
+		turn.color = engine.getCurrent();
+		out.push_back(turn);
+	}
+	return 1;
+}
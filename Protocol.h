@@ -0,0 +1,110 @@
+///Binary wire protocol (no SDL, shared by the game and the server)
+
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+///Include local modules
+#include "Records.h"
+#include "Constants.h"
+#include "Engine.h"
+
+///Misc library inclusion
+#include <string>
+using std::string;
+#include <vector>
+using std::vector;
+
+///Protocol identification (first message on both sides)
+#define PROTOCOL_MAGIC 0x4f44554c
+#define PROTOCOL_VERSION 3
+
+///Frame header size (type, payload length)
+#define FRAME_HEADER 2
+
+///Message types
+enum MessageType{
+	MSG_NONE = 0,
+	///client -> server
+	MSG_HELLO,        ///value: protocol version (also sent back by the server)
+	MSG_JOIN,         ///value: match
+	MSG_ROLL_REQUEST, ///roll the dice (current player)
+	MSG_MOVE_REQUEST, ///pawn: pawn to move (current player, after a roll)
+	MSG_RESYNC,       ///seq: last applied sequence number, asks for a snapshot
+	///server -> client
+	MSG_SEAT,         ///color: seat taken
+	MSG_SNAPSHOT,     ///seq, players, turn, roll: full state (on start and resync)
+	MSG_TURN,         ///seq, color: player to roll
+	MSG_ROLL,         ///seq, color, value: dice result
+	MSG_MOVE,         ///seq, color, pawn, state: moved pawn (pawn PASS if the turn passed)
+	MSG_CAPTURE,      ///seq, color, pawn, state: pawn sent back to base
+	MSG_END,          ///seq, order: finish order
+	MSG_LEFT,         ///color: player disconnected, match closed
+	MSG_ERROR,        ///value: ErrorCodes
+	///client -> server (version 2)
+	MSG_WATCH,        ///value: match, follow it without a seat
+	///peer <-> peer (version 3, relayed by the lockstep host)
+	MSG_TICK,         ///seq: round, color, value: revealed nonce, commit: seal of the next nonce,
+	                  ///hash: state hash when revealed
+	MSG_CHOICE,       ///seq: round, color, pawn: pawn picked after the roll of the round
+	MSG_TYPES
+};
+
+///Refused command reasons
+enum ErrorCodes{
+	ERR_NONE = 0, ERR_VERSION, ERR_UNEXPECTED, ERR_BAD_MATCH, ERR_FULL, ERR_NOT_STARTED,
+	ERR_NOT_YOUR_TURN, ERR_ROLLED, ERR_ROLL_FIRST, ERR_ILLEGAL
+};
+
+///Decoded message (fields a type does not use are 0)
+///Every server message that changes the match state carries the next sequence number,
+///so a client that misses or misapplies one asks for a snapshot instead of drifting.
+struct Message{
+
+	///Constructor
+	///Args:
+	///MessageType type - message type
+	Message(MessageType type = MSG_NONE);
+
+	MessageType type;
+	unsigned seq;
+	unsigned value;
+	Colors color;
+	int pawn;
+	PawnRecord state;
+	vector<Colors> order;
+	vector<PlayerRecord> players;
+	int turn, roll;
+	unsigned commit, hash;
+};
+
+class Protocol{
+public:
+
+	///Append an encoded message to a buffer
+	///Args:
+	///const Message& m - message
+	///string& out - output buffer
+	static void encode(const Message& m, string& out);
+
+	///Decode the first message of a buffer
+	///(returns the bytes used, 0 if the message is incomplete, -1 if the data is malformed)
+	///Args:
+	///const char* data - received data
+	///size_t size - received data size
+	///Message& m - decoded message
+	static int decode(const char* data, size_t size, Message& m);
+
+	///Encoded size of a fixed-layout message type (-1 for variable sizes)
+	static int size(MessageType type);
+
+	///Apply a move and describe it as MOVE, CAPTURE and TURN / END messages
+	///(returns 0 if the move is not legal)
+	///Args:
+	///Engine& engine - match state
+	///int pawn - pawn of the current player, PASS if the turn passes
+	///unsigned& seq - last sequence number (incremented per message)
+	///vector<Message>& out - appended messages
+	static bool play(Engine& engine, int pawn, unsigned& seq, vector<Message>& out);
+};
+
+#endif
@@ -0,0 +1,38 @@
+///Game state records (no SDL, shared by the game, Recovery and the server)
+
+#ifndef RECORDS_H
+#define RECORDS_H
+
+#include <vector>
+using std::vector;
+
+///Player colors
+enum Colors
+{
+	NONE = 0, YELLOW, RED, BLUE
+};
+
+///Pawn index of a turn without a move
+#define PASS -1
+
+/// the saved data of one pawn
+struct PawnRecord
+{
+	int position;
+	int x, y;
+};
+
+/// the saved data of one player
+struct PlayerRecord
+{
+	Colors color;
+	int steps;
+	int taken;
+	int lost;
+	int active;
+	int finished;
+	int diceRoll;
+	vector<PawnRecord> pawns;
+};
+
+#endif
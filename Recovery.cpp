@@ -6,8 +6,15 @@
  */
 
 #include "Recovery.h"
+#include "Metrics.h"
+#include "Profiler.h"
+#include "Trace.h"
 
 bool Recovery::hasRolled;
+int Recovery::turnCount;
+vector<PlayerRecord> Recovery::records;
+bool Recovery::parsed;
+bool Recovery::enabled = 1;
 
 Recovery::Recovery()
 {
@@ -20,13 +27,19 @@ Recovery::~Recovery()
 	// TODO Auto-generated destructor stub
 }
 
-deque<Player*> Recovery::ReadFromXML()
+bool Recovery::Parse()
 {
-	// the vector which will be returned
-	deque<Player*> result;
+	// forget the previous state
+	records.clear();
+	parsed = 0;
 
 	// sets the flag to false
 	hasRolled = 0;
+	turnCount = 0;
+
+	// replays start from a fresh game
+	if (!enabled)
+		return 0;
 
 	pugi::xml_document doc;
 	pugi::xml_parse_result res = doc.load_file("Recovery.xml");
@@ -36,38 +49,36 @@ deque<Player*> Recovery::ReadFromXML()
 	{
 		// show what is the problem
 		cerr << "ERROR with the xml file: " << res.description() << endl;
-		// return empty deque
-		return result;
+		return 0;
 	}
 
 	// make a variable with contains the data in which player you are in
 	pugi::xml_node players = doc.first_child();
-	// take the correct data for the flag
-	hasRolled = players.first_attribute().as_bool();
+	// take the correct data for the flags
+	hasRolled = players.attribute("Rolled").as_bool();
+	turnCount = players.attribute("Turn").as_int();
 
 	// for each node of the players
 	for (pugi::xml_node player = players.first_child(); player;
 			player = player.next_sibling())
 	{
-
 		// making helper object
-		Player* person = new Player(NONE);
-		// fill the Player object with the data from the xml
+		PlayerRecord person;
+		// fill the record with the data from the xml
 		// static_cast<Colors> - so we can give the right type of the color
-		person->setEColor(
-				static_cast<Colors>(player.child("Color").text().as_int()));
-		person->setISteps(player.child("Steps").text().as_int());
-		person->setITaken(player.child("Taken").text().as_int());
-		person->setILost(player.child("Lost").text().as_int());
-		person->setIActivePawns(
-				player.child("Active").text().as_int());
-		person->setIFinishPosition(
-				player.child("Finished").text().as_int());
-		person->setIDiceRoll(
-				player.child("LastDiceRoll").text().as_int());
-
-		// read pawn positions
-		int count = 0;
+		person.color = static_cast<Colors>(
+				player.child("Color").text().as_int());
+		person.steps = player.child("Steps").text().as_int();
+		person.taken = player.child("Taken").text().as_int();
+		person.lost = player.child("Lost").text().as_int();
+		person.active = player.child("Active").text().as_int();
+		person.finished = player.child("Finished").text().as_int();
+		person.diceRoll = player.child("LastDiceRoll").text().as_int();
+
+		// skip players without a valid color
+		if (person.color < YELLOW || person.color > BLUE)
+			continue;
+
 		// the node of the pawns
 		pugi::xml_node pawns = player.child("Pawns");
 		// for each pawn
@@ -75,30 +86,136 @@ deque<Player*> Recovery::ReadFromXML()
 				pawn.next_sibling())
 		{
 			// put the data in the vector in the correct order
-			person->m_vPawns[count]->setIPosition(
-					pawn.attribute("Pos").as_int());
-			person->m_vPawns[count]->setIXPosition(
-					pawn.attribute("PosX").as_int());
-			person->m_vPawns[count]->setIYPosition(
-					pawn.attribute("PosY").as_int());
-			// increment the helper variable
-			count++;
+			PawnRecord record;
+			record.position = pawn.attribute("Pos").as_int();
+			record.x = pawn.attribute("PosX").as_int();
+			record.y = pawn.attribute("PosY").as_int();
+			person.pawns.push_back(record);
 		}
-		// fill the deque which will be returned
-		result.push_back(person);
+		// fill the parsed state
+		records.push_back(person);
+	}
+
+	parsed = 1;
+	return 1;
+}
+
+RecoverySummary Recovery::Probe()
+{
+	RecoverySummary summary;
+
+	// parse the file only if it was not parsed already
+	if (!parsed)
+		Parse();
+
+	summary.valid = parsed && records.size() > 0;
+	summary.players = records.size();
+	summary.turn = turnCount;
+	summary.rolled = hasRolled;
+	return summary;
+}
+
+void Recovery::Discard()
+{
+	records.clear();
+	parsed = 0;
+}
+
+void Recovery::Load(const vector<PlayerRecord>& players, int turn, bool rolled)
+{
+	records = players;
+	turnCount = turn;
+	hasRolled = rolled;
+	parsed = 1;
+}
+
+void Recovery::ReadFromXML(Player slots[PLAYERS], deque<Player*>& order)
+{
+	order.clear();
 
+	// read the file if Probe() did not do it already
+	if (!parsed && !Parse())
+	{
+		// leave the order empty
+		return;
+	}
+
+	// for each saved player
+	for (unsigned i = 0; i < records.size() && i < PLAYERS; i++)
+	{
+		// reuse the slot of the player
+		Player* person = &slots[i];
+		person->reset(records[i].color);
+		// fill the Player object with the parsed data
+		person->setISteps(records[i].steps);
+		person->setITaken(records[i].taken);
+		person->setILost(records[i].lost);
+		person->setIActivePawns(records[i].active);
+		person->setIFinishPosition(records[i].finished);
+		person->setIDiceRoll(records[i].diceRoll);
+
+		// for each pawn
+		for (unsigned j = 0;
+				j < records[i].pawns.size() && j < person->m_vPawns.size();
+				j++)
+		{
+			// put the data in the vector in the correct order
+			person->m_vPawns[j]->setIPosition(records[i].pawns[j].position);
+			person->m_vPawns[j]->setIXPosition(records[i].pawns[j].x);
+			person->m_vPawns[j]->setIYPosition(records[i].pawns[j].y);
+		}
+		// put the player in turn order
+		order.push_back(person);
+	}
+
+	// the state is taken over by the game
+	Discard();
+}
+
+vector<PlayerRecord> Recovery::ToRecords(const deque<Player*>& players)
+{
+	vector<PlayerRecord> result;
+	// for each player
+	for (unsigned i = 0; i < players.size(); i++)
+	{
+		PlayerRecord person;
+		person.color = players[i]->getEColor();
+		person.steps = players[i]->getISteps();
+		person.taken = players[i]->getITaken();
+		person.lost = players[i]->getILost();
+		person.active = players[i]->getIActivePawns();
+		person.finished = players[i]->getIFinishPosition();
+		person.diceRoll = players[i]->getIDiceRoll();
+
+		// for each pawn in the same order as in the file
+		for (unsigned j = 0; j < players[i]->m_vPawns.size(); j++)
+		{
+			PawnRecord pawn;
+			pawn.position = players[i]->m_vPawns[j]->getIPosition();
+			pawn.x = players[i]->m_vPawns[j]->getIXPosition();
+			pawn.y = players[i]->m_vPawns[j]->getIYPosition();
+			person.pawns.push_back(pawn);
+		}
+		result.push_back(person);
 	}
 	return result;
 }
 
-void Recovery::WriteXML(deque<Player*> players, bool rolled)
+void Recovery::WriteXML(const deque<Player*>& players, bool rolled)
 {
 	hasRolled = rolled;
+	// replays must not overwrite the saved game
+	if (!enabled)
+		return;
+	TRACE_SCOPE("Recovery::WriteXML");
+	Profiler::begin(PHASE_RECOVERY);
+	Uint64 start = SDL_GetPerformanceCounter();
 	pugi::xml_document doc;
 	doc.save_file("Recovery.xml");
 	// making the biggest node
 	pugi::xml_node game = doc.append_child("Game");
 	game.append_attribute("Rolled") = rolled;
+	game.append_attribute("Turn") = turnCount;
 
 	for (unsigned int i = 0; i < players.size(); i++)
 	{
@@ -175,9 +292,12 @@ void Recovery::WriteXML(deque<Player*> players, bool rolled)
 	}
 
 	doc.save_file("Recovery.xml");
+	Metrics::count(METRIC_SAVES);
+	Metrics::observe(HISTOGRAM_SAVE, (double)(SDL_GetPerformanceCounter()-start)*1000/SDL_GetPerformanceFrequency());
+	Profiler::end(PHASE_RECOVERY);
 }
 
-void Recovery::Print(deque<Player*> players)
+void Recovery::Print(const deque<Player*>& players)
 {
 	// for each player
 	for (unsigned int i = 0; i < players.size(); i++)
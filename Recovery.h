@@ -14,30 +14,77 @@
 #include <iostream>
 #include <sstream>
 #include <deque>
+#include <vector>
 
 using std::endl;
 using std::cout;
 using std::cerr;
 using std::deque;
+using std::vector;
 using std::stringstream;
 
+/// short description of the saved game for the title screen
+struct RecoverySummary
+{
+	/// the file exists and holds at least one player
+	bool valid;
+	/// how many players are saved
+	int players;
+	/// how many turns were played
+	int turn;
+	/// if the current player has already rolled
+	bool rolled;
+};
+
 class Recovery
 {
 public:
 	Recovery();
 	virtual ~Recovery();
 
-	/// returns deque with all the data from the file
-	static deque< Player* > ReadFromXML();
+	/// parses the file once and keeps the parsed state
+	/// returns a summary without making any players
+	static RecoverySummary Probe();
+
+	/// fills the player slots with the data from the file in place and puts
+	/// them in turn order (players beyond PLAYERS are skipped)
+	/// takes over the state kept by Probe() if there is one
+	static void ReadFromXML(Player slots[PLAYERS], deque<Player*>& order);
+
+	/// forgets the state kept by Probe()
+	static void Discard();
+
+	/// keeps a state received from elsewhere (a server) instead of the file
+	/// ReadFromXML() takes it over the same way
+	static void Load(const vector<PlayerRecord>& players, int turn, bool rolled);
 
 	/// puts data in the same file and deletes the previous data
-	static void WriteXML(deque <Player*>, bool rolled = 0);
+	static void WriteXML(const deque<Player*>&, bool rolled = 0);
 
 	/// prints the data
-	static void Print(deque <Player*>);
+	static void Print(const deque<Player*>&);
+
+	/// returns the data of the players in the saved form
+	static vector<PlayerRecord> ToRecords(const deque<Player*>&);
 
 	/// flag if player rolled the dice this turn
 	static bool hasRolled;
+
+	/// how many turns were played in the saved game
+	static int turnCount;
+
+	/// flag if the file is used at all (off while recording or playing a replay)
+	static bool enabled;
+
+private:
+	/// reads the file into the parsed state
+	static bool Parse();
+
+	/// the parsed state of the file
+	static vector<PlayerRecord> records;
+
+	/// flag if the parsed state is available
+	static bool parsed;
 };
 
 #endif /* RECOVERY_H_ */
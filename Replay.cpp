@@ -0,0 +1,191 @@
+#include "Replay.h"
+
+#include <cstring>
+
+static const char MAGIC[4] = {'L', 'U', 'D', 'R'};
+static const Uint16 VERSION = 1;
+
+ofstream Replay::mOut;
+ifstream Replay::mIn;
+Uint32 Replay::miFrameTime = 0;
+vector<ReplayEvent> Replay::mFrame;
+unsigned Replay::miNextEvent = 0;
+unsigned Replay::miFrames = 0;
+bool Replay::mbFrameOpen = 0;
+
+//Raw field I/O (host byte order)
+template<class T> static void put(ofstream& f, T v){
+	f.write((const char*)&v, sizeof(T));
+}
+
+template<class T> static bool get(ifstream& f, T& v){
+	return (bool)f.read((char*)&v, sizeof(T));
+}
+
+
+
+
+bool Replay::record(const char* path, Uint32 seed){
+	mOut.open(path, std::ios::binary | std::ios::trunc);
+	if(!mOut){
+		cerr << "Replay error: cannot create " << path << endl;
+		return 0;
+	}
+	mOut.write(MAGIC, sizeof(MAGIC));
+	put(mOut, VERSION);
+	put(mOut, seed);
+	miFrames = 0;
+	mbFrameOpen = 0;
+	return 1;
+}
+
+bool Replay::play(const char* path, Uint32& seed){
+	mIn.open(path, std::ios::binary);
+	char magic[4];
+	Uint16 version;
+	if(!mIn || !mIn.read(magic, sizeof(magic)) || memcmp(magic, MAGIC, sizeof(MAGIC))
+	   || !get(mIn, version) || version!=VERSION || !get(mIn, seed)){
+		cerr << "Replay error: " << path << " is not a valid replay" << endl;
+		mIn.close();
+		return 0;
+	}
+	miFrames = 0;
+	mFrame.clear();
+	miNextEvent = 0;
+	return 1;
+}
+
+bool Replay::isRecording(){
+	return mOut.is_open();
+}
+
+bool Replay::isPlaying(){
+	return mIn.is_open();
+}
+
+
+
+
+void Replay::beginFrame(Uint32 dt){
+	if(!isRecording()) return;
+	flush();
+	miFrameTime = dt;
+	mFrame.clear();
+	miNextEvent = 0;
+	mbFrameOpen = 1;
+}
+
+void Replay::recordEvent(const SDL_Event& e){
+	if(!isRecording() || !mbFrameOpen) return;
+	//Keep only the events the game reacts to
+	switch(e.type){
+		case SDL_QUIT:
+		case SDL_KEYDOWN: case SDL_KEYUP:
+		case SDL_MOUSEBUTTONDOWN: case SDL_MOUSEBUTTONUP:
+		case SDL_MOUSEMOTION:
+			mFrame.push_back(pack(e));
+			break;
+	}
+}
+
+void Replay::flush(){
+	if(!mbFrameOpen) return;
+	put(mOut, miFrameTime);
+	put(mOut, (Uint16)mFrame.size());
+	for(unsigned i = 0; i < mFrame.size(); ++i){
+		put(mOut, mFrame[i].type);
+		put(mOut, mFrame[i].a);
+		put(mOut, mFrame[i].b);
+		put(mOut, mFrame[i].c);
+	}
+	mbFrameOpen = 0;
+	miFrames++;
+}
+
+
+
+
+bool Replay::nextFrame(Uint32& dt){
+	if(!isPlaying()) return 0;
+	Uint16 count;
+	if(!get(mIn, dt) || !get(mIn, count)) return 0;
+	mFrame.resize(count);
+	for(unsigned i = 0; i < count; ++i){
+		ReplayEvent& r = mFrame[i];
+		if(!get(mIn, r.type) || !get(mIn, r.a) || !get(mIn, r.b) || !get(mIn, r.c)){
+			cerr << "Replay error: file is truncated" << endl;
+			return 0;
+		}
+	}
+	miNextEvent = 0;
+	miFrames++;
+	return 1;
+}
+
+bool Replay::pollEvent(SDL_Event& e){
+	//While recording the frame holds live events that were already handled
+	if(!isPlaying() || miNextEvent >= mFrame.size()) return 0;
+	e = unpack(mFrame[miNextEvent++]);
+	return 1;
+}
+
+unsigned Replay::frames(){
+	return miFrames;
+}
+
+void Replay::close(){
+	if(isRecording()){
+		flush();
+		mOut.close();
+	}
+	if(isPlaying()) mIn.close();
+}
+
+
+
+
+ReplayEvent Replay::pack(const SDL_Event& e){
+	ReplayEvent r = {e.type, 0, 0, 0};
+	switch(e.type){
+		case SDL_KEYDOWN: case SDL_KEYUP:
+			r.a = e.key.keysym.sym;
+			r.b = e.key.repeat;
+			break;
+		case SDL_MOUSEBUTTONDOWN: case SDL_MOUSEBUTTONUP:
+			r.a = e.button.button;
+			r.b = e.button.x;
+			r.c = e.button.y;
+			break;
+		case SDL_MOUSEMOTION:
+			r.a = e.motion.state;
+			r.b = e.motion.x;
+			r.c = e.motion.y;
+			break;
+	}
+	return r;
+}
+
+SDL_Event Replay::unpack(const ReplayEvent& r){
+	SDL_Event e;
+	memset(&e, 0, sizeof(e));
+	e.type = r.type;
+	switch(r.type){
+		case SDL_KEYDOWN: case SDL_KEYUP:
+			e.key.keysym.sym = r.a;
+			e.key.repeat = r.b;
+			e.key.state = r.type==SDL_KEYDOWN ? SDL_PRESSED : SDL_RELEASED;
+			break;
+		case SDL_MOUSEBUTTONDOWN: case SDL_MOUSEBUTTONUP:
+			e.button.button = r.a;
+			e.button.x = r.b;
+			e.button.y = r.c;
+			e.button.state = r.type==SDL_MOUSEBUTTONDOWN ? SDL_PRESSED : SDL_RELEASED;
+			break;
+		case SDL_MOUSEMOTION:
+			e.motion.state = r.a;
+			e.motion.x = r.b;
+			e.motion.y = r.c;
+			break;
+	}
+	return e;
+}
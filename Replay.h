@@ -0,0 +1,94 @@
+///Input recording and playback
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+///Include SDL modules
+#include <SDL2/SDL.h>
+
+///Misc library inclusion
+#include <iostream>
+using std::cerr;
+using std::endl;
+#include <fstream>
+using std::ifstream;
+using std::ofstream;
+#include <vector>
+using std::vector;
+
+///Recorded event (only the fields the game reads)
+struct ReplayEvent{
+	Uint32 type;
+	Sint32 a, b, c;
+};
+
+///Replay file layout:
+///header - "LUDR", Uint16 version, Uint32 RNG seed
+///frames - Uint32 frame duration (ms), Uint16 event count, ReplayEvent[count]
+class Replay{
+public:
+
+	///Start recording
+	///Args:
+	///const char* path - output file
+	///Uint32 seed - RNG seed of the session
+	static bool record(const char* path, Uint32 seed);
+
+	///Start playback
+	///Args:
+	///const char* path - input file
+	///Uint32& seed - recorded RNG seed
+	static bool play(const char* path, Uint32& seed);
+
+	///Mode getters
+	static bool isRecording();
+	static bool isPlaying();
+
+	///Start recording a frame
+	///Args:
+	///Uint32 dt - frame duration (in ms)
+	static void beginFrame(Uint32 dt);
+
+	///Record a polled event
+	///Args:
+	///const SDL_Event& e - event
+	static void recordEvent(const SDL_Event& e);
+
+	///Load next recorded frame (returns 0 at end of file)
+	///Args:
+	///Uint32& dt - frame duration (in ms)
+	static bool nextFrame(Uint32& dt);
+
+	///Get next event of the current played frame (returns 0 when none remain or not playing)
+	///Args:
+	///SDL_Event& e - event container
+	static bool pollEvent(SDL_Event& e);
+
+	///Number of frames recorded or played
+	static unsigned frames();
+
+	///Finish recording or playback
+	static void close();
+
+private:
+
+	///Convert between SDL and recorded events
+	static ReplayEvent pack(const SDL_Event& e);
+	static SDL_Event unpack(const ReplayEvent& r);
+
+	///Write recorded frame
+	static void flush();
+
+	///Files
+	static ofstream mOut;
+	static ifstream mIn;
+
+	///Current frame
+	static Uint32 miFrameTime;
+	static vector<ReplayEvent> mFrame;
+	static unsigned miNextEvent;
+	static unsigned miFrames;
+	static bool mbFrameOpen;
+};
+
+#endif
@@ -0,0 +1,131 @@
+#include "Resources.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+using std::vector;
+
+const char* Resources::msOwner = "other";
+size_t Resources::miTotal = 0;
+std::atomic<size_t> Resources::miKindBytes[RESOURCE_KINDS];
+bool Resources::mbOverBudget = 0;
+
+//Report names of the resource kinds
+static const char* KIND_NAMES[RESOURCE_KINDS] = {"texture", "text", "font", "sound"};
+
+//Bytes in a megabyte
+#define MB (1024.0*1024.0)
+
+map<const void*, Resources::Entry>& Resources::entries(){
+	static map<const void*, Entry>* registered = new map<const void*, Entry>;
+	return *registered;
+}
+
+void Resources::add(const void* handle, ResourceKinds kind, const string& name, size_t bytes){
+	if(handle==NULL) return;
+	//Replace a stale entry of a reused handle
+	remove(handle);
+	Entry e = {kind, name, msOwner, bytes};
+	entries()[handle] = e;
+	miTotal += bytes;
+	miKindBytes[kind] += bytes;
+
+	//Warn once per budget overrun
+	size_t budget = (size_t)RESOURCE_BUDGET*1024;
+	if(miTotal>budget && !mbOverBudget){
+		mbOverBudget = 1;
+		char line[160];
+		snprintf(line, sizeof(line), "Resource warning: %.1f MB resident after loading %s (%s), RESOURCE_BUDGET is %.1f MB",
+		         miTotal/MB, name.c_str(), msOwner, budget/MB);
+		cerr << line << endl;
+	}
+}
+
+void Resources::remove(const void* handle){
+	map<const void*, Entry>::iterator it = entries().find(handle);
+	if(it==entries().end()) return;
+	miTotal -= it->second.bytes;
+	miKindBytes[it->second.kind] -= it->second.bytes;
+	entries().erase(it);
+	if(miTotal<=(size_t)RESOURCE_BUDGET*1024) mbOverBudget = 0;
+}
+
+
+
+
+size_t Resources::bytes(ResourceKinds kind){
+	return miKindBytes[kind];
+}
+
+size_t Resources::textureBytes(SDL_Texture* t){
+	Uint32 format;
+	int w, h;
+	if(t==NULL || SDL_QueryTexture(t, &format, NULL, &w, &h)!=0) return 0;
+	return (size_t)w*h*SDL_BYTESPERPIXEL(format);
+}
+
+size_t Resources::fileBytes(const string& path){
+	std::ifstream in(path.c_str(), std::ios::binary|std::ios::ate);
+	if(!in) return 0;
+	return in.tellg();
+}
+
+
+
+
+//Resources of one file loaded by one subsystem
+struct ResourceGroup{
+	ResourceKinds kind;
+	string name;
+	const char* owner;
+	int copies;
+	size_t bytes;
+};
+
+//Largest groups first
+static bool larger(const ResourceGroup& a, const ResourceGroup& b){
+	return a.bytes>b.bytes;
+}
+
+void Resources::report(ostream& out){
+	char line[200];
+	map<const void*, Entry>& all = entries();
+
+	//Totals per kind
+	int count[RESOURCE_KINDS] = {0};
+	size_t bytes[RESOURCE_KINDS] = {0};
+	for(map<const void*, Entry>::iterator it = all.begin(); it!=all.end(); ++it){
+		count[it->second.kind]++;
+		bytes[it->second.kind] += it->second.bytes;
+	}
+	snprintf(line, sizeof(line), "Resources: %d resident, %.1f MB (budget %.1f MB)",
+	         (int)all.size(), miTotal/MB, (size_t)RESOURCE_BUDGET*1024/MB);
+	out << line << endl;
+	for(int k = 0; k < RESOURCE_KINDS; ++k){
+		snprintf(line, sizeof(line), "  %-8s %5d %9.1f KB", KIND_NAMES[k], count[k], bytes[k]/1024.0);
+		out << line << endl;
+	}
+
+	//Copies of the same file by the same subsystem (fonts are counted with their file size)
+	vector<ResourceGroup> groups;
+	for(map<const void*, Entry>::iterator it = all.begin(); it!=all.end(); ++it){
+		const Entry& e = it->second;
+		unsigned g = 0;
+		while(g<groups.size() && (groups[g].kind!=e.kind || groups[g].name!=e.name || groups[g].owner!=e.owner)) g++;
+		if(g==groups.size()){
+			ResourceGroup added = {e.kind, e.name, e.owner, 0, 0};
+			groups.push_back(added);
+		}
+		groups[g].copies++;
+		groups[g].bytes += e.bytes;
+	}
+	std::sort(groups.begin(), groups.end(), larger);
+
+	out << "Top consumers:" << endl;
+	for(unsigned g = 0; g < groups.size() && (int)g < RESOURCE_TOP; ++g){
+		snprintf(line, sizeof(line), "  %9.1f KB %4dx %-8s %-12s %s", groups[g].bytes/1024.0, groups[g].copies,
+		         KIND_NAMES[groups[g].kind], groups[g].owner, groups[g].name.c_str());
+		out << line << endl;
+	}
+}
@@ -0,0 +1,98 @@
+///Resource tracker (resident textures, fonts and sound effects with their size, copies and the subsystem that loaded them)
+
+#ifndef RESOURCES_H
+#define RESOURCES_H
+
+///Include local modules
+#include "Shared.h"
+
+///Misc library inclusion
+#include <atomic>
+#include <map>
+using std::map;
+using std::ostream;
+using std::cerr;
+using std::endl;
+
+///Tracked resource kinds
+enum ResourceKinds{RESOURCE_TEXTURE, RESOURCE_TEXT, RESOURCE_FONT, RESOURCE_SOUND, RESOURCE_KINDS};
+
+class Resources{
+public:
+
+	///Subsystem scope (resources added while it lives are credited to it)
+	class Scope{
+	public:
+
+		///Enter a subsystem
+		///Args:
+		///const char* owner - subsystem name (a string literal, it is not copied)
+		Scope(const char* owner): mPrevious(msOwner){ msOwner = owner; }
+
+		///Return to the enclosing subsystem
+		~Scope(){ msOwner = mPrevious; }
+
+	private:
+
+		const char* mPrevious;
+	};
+
+	///Register a loaded resource (warns once when the total goes over RESOURCE_BUDGET)
+	///Args:
+	///const void* handle - SDL object of the resource
+	///ResourceKinds kind - resource kind
+	///const string& name - source file (copies of one file are counted together)
+	///size_t bytes - resident size
+	static void add(const void* handle, ResourceKinds kind, const string& name, size_t bytes);
+
+	///Unregister a resource before it is freed (unknown handles are ignored)
+	///Args:
+	///const void* handle - SDL object of the resource
+	static void remove(const void* handle);
+
+	///Registered bytes of a kind (any thread)
+	///Args:
+	///ResourceKinds kind - resource kind
+	static size_t bytes(ResourceKinds kind);
+
+	///Resident size of a texture (width*height*bytes per pixel)
+	///Args:
+	///SDL_Texture* t - texture
+	static size_t textureBytes(SDL_Texture* t);
+
+	///Size of a file (0 if it cannot be read)
+	///Args:
+	///const string& path - file path
+	static size_t fileBytes(const string& path);
+
+	///Write totals per kind and the RESOURCE_TOP largest consumers
+	///Args:
+	///ostream& out - output stream
+	static void report(ostream& out);
+
+private:
+
+	///Registered resource
+	struct Entry{
+		ResourceKinds kind;
+		string name;
+		const char* owner;
+		size_t bytes;
+	};
+
+	///Registered resources by handle (never destroyed, textures of static objects
+	///are freed after the other statics are gone)
+	static map<const void*, Entry>& entries();
+
+	///Subsystem of resources added now
+	static const char* msOwner;
+
+	///Registered bytes, in total and per kind (read by the metrics thread)
+	static size_t miTotal;
+	static std::atomic<size_t> miKindBytes[RESOURCE_KINDS];
+
+	///Over budget flag (the warning is repeated after the total drops under the budget)
+	static bool mbOverBudget;
+};
+
+#endif
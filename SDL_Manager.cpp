@@ -1,23 +1,37 @@
 #include "SDL_Manager.h"
+#include "Metrics.h"
+#include "Sound.h"
 
-//SDL initializing constructor
+std::atomic<unsigned> SDL_Manager::miUnderruns(0);
+std::atomic<Uint32> SDL_Manager::miLastMix(0);
+Uint32 SDL_Manager::miAudioOpened = 0;
+Uint32 SDL_Manager::miMixLimit = 0;
+
+//Constructor
 SDL_Manager::SDL_Manager(){
+	mWindow = NULL;
+	mRenderer = NULL;
+	miAudioBuffer = 0;
+}
+
+//SDL initializing function
+void SDL_Manager::init(bool vsync, int audioBuffer){
     	
 #ifdef DEBUG
 		std::cout << "Init called" << endl;
 #endif
 	
 	//Try to initialize SDL_main
-	if(SDL_Init(SDL_INIT_VIDEO)<0){
+	if(SDL_Init(SDL_INIT_VIDEO|SDL_INIT_AUDIO)<0){
 		cerr << "SDL Error: " << SDL_GetError() << endl;
 	} else {
 	//Try to initialize SDL_image
 	if(!IMG_Init(IMG_INIT_PNG)){
 		cerr << "IMG Error: " << IMG_GetError() << endl;
 	} else {
-	//Try to initialize SDL_mixer
-	if(Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048)<0){
-		cerr << "MIX Error: " << Mix_GetError() << endl;
+	//Try to open the audio device (the only place it is opened)
+	if(!openAudio(audioBuffer) && (audioBuffer>=AUDIO_FALLBACK_BUFFER || !openAudio(AUDIO_FALLBACK_BUFFER))){
+		cerr << "MIX Error: cannot open audio device" << endl;
 	} else {
 	//Try to initialize SDL_ttf
 	if(TTF_Init()==-1){
@@ -34,7 +48,9 @@ SDL_Manager::SDL_Manager(){
 			cerr << "Window error: " << SDL_GetError() << endl;
 		} else {
 			//Create renderer
-			mRenderer = SDL_CreateRenderer(mWindow, -1, SDL_RENDERER_ACCELERATED|SDL_RENDERER_PRESENTVSYNC);
+			mRenderer = SDL_CreateRenderer(mWindow, -1, SDL_RENDERER_ACCELERATED|(vsync?SDL_RENDERER_PRESENTVSYNC:0));
+			//Fall back to the software renderer (no GPU or dummy video driver)
+			if(mRenderer==NULL) mRenderer = SDL_CreateRenderer(mWindow, -1, SDL_RENDERER_SOFTWARE);
 			//Renderer integrity check
 			if(mRenderer==NULL){
 				cerr << "Renderer error: " << SDL_GetError() << endl;
@@ -46,6 +62,60 @@ SDL_Manager::SDL_Manager(){
 	}
 }
 
+//Open audio device
+bool SDL_Manager::openAudio(int buffer){
+	if(Mix_OpenAudio(AUDIO_RATE, MIX_DEFAULT_FORMAT, AUDIO_CHANNELS, buffer)<0){
+		cerr << "MIX Error: " << Mix_GetError() << endl;
+		return 0;
+	}
+	//Get obtained sample rate
+	int rate = AUDIO_RATE, channels;
+	Uint16 format;
+	Mix_QuerySpec(&rate, &format, &channels);
+	miAudioBuffer = buffer;
+	//A buffer coming over twice as late as its length counts as an underrun
+	miMixLimit = 2*buffer*1000/rate+2;
+	miAudioOpened = SDL_GetTicks();
+	miUnderruns = 0;
+	miLastMix = 0;
+	Mix_SetPostMix(onMix, NULL);
+#ifdef DEBUG
+	cout << "Audio: " << rate << " Hz, " << channels << " channels, " << buffer << " samples" << endl;
+#endif
+	return 1;
+}
+
+//Time audio buffers
+void SDL_Manager::onMix(void*, Uint8*, int){
+	Uint32 now = SDL_GetTicks();
+	Uint32 last = miLastMix.exchange(now);
+	//Device start-up is not counted
+	if(now-miAudioOpened<1000) return;
+	if(last && now-last>miMixLimit){
+		miUnderruns++;
+		Metrics::count(METRIC_UNDERRUNS);
+	}
+}
+
+//Audio fallback check
+void SDL_Manager::updateAudio(){
+	//Already on the safe buffer or no trouble yet
+	if(!miAudioBuffer || miAudioBuffer>=AUDIO_FALLBACK_BUFFER || miUnderruns<(unsigned)AUDIO_UNDERRUN_LIMIT) return;
+	cerr << "Audio: " << miUnderruns << " underruns with a " << miAudioBuffer
+		 << " sample buffer, switching to " << AUDIO_FALLBACK_BUFFER << endl;
+	//Reopen device, keeping what is playing
+	Sound::suspend();
+	Mix_SetPostMix(NULL, NULL);
+	Mix_CloseAudio();
+	if(openAudio(AUDIO_FALLBACK_BUFFER)) Sound::resume();
+	else miAudioBuffer = 0;
+}
+
+//Get underrun count
+unsigned SDL_Manager::getUnderruns(){
+	return miUnderruns;
+}
+
 //Get renderer
 SDL_Renderer * SDL_Manager::getRenderer() const {
     return mRenderer;
@@ -57,6 +127,9 @@ SDL_Manager::~SDL_Manager(){
 	SDL_DestroyRenderer(mRenderer);
 	//Release window
 	SDL_DestroyWindow(mWindow);
+	//Close audio device
+	Mix_SetPostMix(NULL, NULL);
+	Mix_CloseAudio();
 	//SDL Quit functions
 	Mix_Quit();
 	IMG_Quit();
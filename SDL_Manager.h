@@ -16,6 +16,9 @@ using std::endl;
 ///Include local modules
 #include "Shared.h"
 
+///Misc library inclusion
+#include <atomic>
+
 class SDL_Manager{
 
 public:
@@ -23,6 +26,19 @@ public:
 	///Constructor
 	SDL_Manager();
 
+	///Initialize SDL, window, renderer and audio device
+	///Args:
+	///bool vsync - synchronize presenting with the display
+	///int audioBuffer - audio buffer size (in samples)
+	void init(bool vsync = 1, int audioBuffer = AUDIO_BUFFER);
+
+	///Reopen the audio device with the safe buffer size after
+	///repeated underruns (called once per frame)
+	void updateAudio();
+
+	///Audio underruns counted since the audio device was opened
+	static unsigned getUnderruns();
+
 	///Renderer getter
 	SDL_Renderer* getRenderer() const;
 
@@ -36,6 +52,24 @@ private:
 
 	///SDL renderer object
 	SDL_Renderer* mRenderer;
+
+	///Open audio device
+	///Args:
+	///int buffer - buffer size (in samples)
+	bool openAudio(int buffer);
+
+	///Mixer callback timing the audio buffers (audio thread)
+	static void onMix(void* udata, Uint8* stream, int len);
+
+	///Audio buffer size (in samples)
+	int miAudioBuffer;
+
+	///Underrun counter and last buffer time (written by the audio thread)
+	static std::atomic<unsigned> miUnderruns;
+	static std::atomic<Uint32> miLastMix;
+
+	///Device open time and longest regular time between buffers (in ms)
+	static Uint32 miAudioOpened, miMixLimit;
 };
 
 #endif
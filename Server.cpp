@@ -0,0 +1,460 @@
+#include "Server.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+
+std::atomic<bool> Server::mbRunning(false);
+
+//Epoll tag of the wake up descriptor (sockets are tagged with their fd)
+#define WAKE_TAG -1
+
+//Epoll tag of a listening socket
+#define LISTENER_TAG(fd) (-2-(fd))
+
+
+
+
+//Constructor
+Worker::Worker(Server& server)
+:mServer(server){
+	miEpoll = epoll_create1(EPOLL_CLOEXEC);
+	miWake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	epoll_event e;
+	e.events = EPOLLIN;
+	e.data.u64 = 0;
+	e.data.fd = WAKE_TAG;
+	epoll_ctl(miEpoll, EPOLL_CTL_ADD, miWake, &e);
+}
+
+//Destructor
+Worker::~Worker(){
+	for(map<int, Session*>::iterator it = mSessions.begin(); it!=mSessions.end(); ++it)
+		delete it->second;
+	for(unsigned i = 0; i < mHandOffs.size(); ++i)
+		::close(mHandOffs[i].first);
+	for(unsigned i = 0; i < mListeners.size(); ++i)
+		::close(mListeners[i]);
+	::close(miWake);
+	::close(miEpoll);
+}
+
+//Watch listening socket
+void Worker::addListener(int fd){
+	mListeners.push_back(fd);
+	epoll_event e;
+	e.events = EPOLLIN;
+	e.data.u64 = 0;
+	e.data.fd = LISTENER_TAG(fd);
+	epoll_ctl(miEpoll, EPOLL_CTL_ADD, fd, &e);
+}
+
+//Queue session and wake the worker
+void Worker::handOff(int fd, const string& input){
+	{
+		std::lock_guard<mutex> lock(mHandOffLock);
+		mHandOffs.push_back(pair<int, string>(fd, input));
+	}
+	uint64_t one = 1;
+	if(::write(miWake, &one, sizeof(one))<0) cerr << "Server error: cannot wake worker" << endl;
+}
+
+//Start thread
+void Worker::start(){
+	mThread = thread(&Worker::run, this);
+}
+
+//Wait for thread
+void Worker::join(){
+	if(mThread.joinable()) mThread.join();
+}
+
+
+
+
+//Event loop
+void Worker::run(){
+	epoll_event events[64];
+	while(Server::isRunning()){
+		//Wake up regularly to notice stop()
+		int count = epoll_wait(miEpoll, events, 64, 200);
+		for(int i = 0; i < count; ++i){
+			int tag = events[i].data.fd;
+			if(tag==WAKE_TAG) takeHandOffs();
+			else if(tag<WAKE_TAG) accept(-2-tag);
+			else {
+				map<int, Session*>::iterator it = mSessions.find(tag);
+				if(it==mSessions.end()) continue;
+				Session* s = it->second;
+				if(events[i].events & (EPOLLERR | EPOLLHUP)) drop(s);
+				else if(events[i].events & EPOLLIN) receive(s);
+				else mPending.insert(tag);
+			}
+		}
+		flushPending();
+	}
+}
+
+//Accept connections
+void Worker::accept(int listener){
+	while(1){
+		int fd = accept4(listener, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if(fd<0) break;
+		attach(fd, "");
+	}
+}
+
+//Take sessions from other workers
+void Worker::takeHandOffs(){
+	uint64_t count;
+	if(::read(miWake, &count, sizeof(count))<0) return;
+	vector<pair<int, string> > handOffs;
+	{
+		std::lock_guard<mutex> lock(mHandOffLock);
+		handOffs.swap(mHandOffs);
+	}
+	for(unsigned i = 0; i < handOffs.size(); ++i)
+		attach(handOffs[i].first, handOffs[i].second);
+}
+
+//Watch session
+void Worker::attach(int fd, const string& input){
+	Session* s = new Session;
+	s->net.attach(fd, input);
+	s->match = -1;
+	s->color = NONE;
+	s->greeted = 0;
+	s->resync = 0;
+	mSessions[fd] = s;
+	epoll_event e;
+	e.events = EPOLLIN;
+	e.data.u64 = 0;
+	e.data.fd = fd;
+	epoll_ctl(miEpoll, EPOLL_CTL_ADD, fd, &e);
+	//Handle commands that came with a hand off
+	if(!input.empty()) receive(s);
+}
+
+
+
+
+//Read session input
+void Worker::receive(Session* s){
+	int fd = s->net.getFd();
+	bool open = s->net.receive();
+	Message m;
+	int result = 0;
+	//Stop if the session was handed off to another worker
+	while(mSessions.count(fd) && (result = s->net.next(m))>0)
+		handle(s, m);
+	if(!mSessions.count(fd)) return;
+	if(!open || result<0) drop(s);
+	else mPending.insert(fd);
+}
+
+//Refuse command
+void Worker::refuse(Session* s, ErrorCodes code){
+	Message error(MSG_ERROR);
+	error.value = code;
+	s->net.send(error);
+}
+
+//Handle command
+void Worker::handle(Session* s, const Message& m){
+	//Version check comes first
+	if(!s->greeted){
+		if(m.type!=MSG_HELLO || m.value!=PROTOCOL_VERSION){
+			refuse(s, ERR_VERSION);
+			s->net.flush();
+			drop(s);
+			return;
+		}
+		Message hello(MSG_HELLO);
+		hello.value = PROTOCOL_VERSION;
+		s->net.send(hello);
+		s->greeted = 1;
+		return;
+	}
+
+	if(m.type==MSG_JOIN || m.type==MSG_WATCH){
+		int id = m.value;
+		if(id<0) refuse(s, ERR_BAD_MATCH);
+		else if(s->match>=0) refuse(s, ERR_UNEXPECTED);
+		//Match is owned by another worker (it gets the greeting and command again)
+		else if(&mServer.getOwner(id)!=this){
+			Worker& owner = mServer.getOwner(id);
+			Message hello(MSG_HELLO);
+			hello.value = PROTOCOL_VERSION;
+			string input;
+			Protocol::encode(hello, input);
+			Protocol::encode(m, input);
+			input += s->net.getInput();
+			s->net.flush();
+			mPending.erase(s->net.getFd());
+			release(s);
+			owner.handOff(s->net.detach(), input);
+			delete s;
+		}
+		else if(m.type==MSG_JOIN) join(s, id);
+		else watch(s, id);
+		return;
+	}
+
+	map<int, Match>::iterator it = mMatches.find(s->match);
+	if(m.type!=MSG_ROLL_REQUEST && m.type!=MSG_MOVE_REQUEST && m.type!=MSG_RESYNC) refuse(s, ERR_UNEXPECTED);
+	else if(it==mMatches.end() || !it->second.started) refuse(s, ERR_NOT_STARTED);
+	//Full state for a client that lost track
+	else if(m.type==MSG_RESYNC) s->net.send(snapshot(it->second));
+	//Commands of the current player (never a spectator)
+	else if(it->second.engine.getCurrent()!=s->color) refuse(s, ERR_NOT_YOUR_TURN);
+	else if(m.type==MSG_ROLL_REQUEST){
+		Match& match = it->second;
+		if(match.engine.getRoll()){ refuse(s, ERR_ROLLED); return; }
+		Message roll(MSG_ROLL);
+		roll.seq = ++match.seq;
+		roll.color = s->color;
+		roll.value = match.engine.roll();
+		broadcast(match, roll);
+		//Play turns without a choice
+		vector<int> moves = match.engine.getMoves();
+		if(moves.size()<=1) move(s->match, moves.empty() ? PASS : moves[0]);
+	}
+	else {
+		if(!it->second.engine.getRoll()) refuse(s, ERR_ROLL_FIRST);
+		else if(!move(s->match, m.pawn)) refuse(s, ERR_ILLEGAL);
+	}
+}
+
+//Find or create match
+Match& Worker::getMatch(int id){
+	map<int, Match>::iterator it = mMatches.find(id);
+	if(it!=mMatches.end()) return it->second;
+	Match& m = mMatches[id];
+	for(int i = 0; i < PLAYERS; ++i) m.seats[i] = -1;
+	m.started = 0;
+	m.seq = 0;
+	return m;
+}
+
+//Seat session
+void Worker::join(Session* s, int id){
+	Match& m = getMatch(id);
+	int seat = 0;
+	while(seat < PLAYERS && m.seats[seat]>=0) seat++;
+	if(m.started || seat==PLAYERS){
+		refuse(s, ERR_FULL);
+		return;
+	}
+	m.seats[seat] = s->net.getFd();
+	s->match = id;
+	s->color = Colors(seat+1);
+	Message taken(MSG_SEAT);
+	taken.color = s->color;
+	s->net.send(taken);
+
+	//Start once all seats are taken
+	if(seat<PLAYERS-1) return;
+	m.started = 1;
+	m.engine.newGame(mServer.getSeed(id));
+	broadcast(m, snapshot(m));
+	Message turn(MSG_TURN);
+	turn.seq = ++m.seq;
+	turn.color = m.engine.getCurrent();
+	broadcast(m, turn);
+}
+
+//Add spectator
+void Worker::watch(Session* s, int id){
+	Match& m = getMatch(id);
+	m.watchers.push_back(s->net.getFd());
+	s->match = id;
+	//Later spectators start from the current state
+	if(m.started) s->net.send(snapshot(m));
+}
+
+//Apply move and announce state changes
+bool Worker::move(int id, int pawn){
+	Match& m = mMatches[id];
+	vector<Message> changes;
+	if(!Protocol::play(m.engine, pawn, m.seq, changes)) return 0;
+	for(unsigned i = 0; i < changes.size(); ++i)
+		broadcast(m, changes[i]);
+	return 1;
+}
+
+//Full match state
+Message Worker::snapshot(Match& m){
+	Message state(MSG_SNAPSHOT);
+	state.seq = m.seq;
+	state.players = m.engine.getPlayers();
+	state.turn = m.engine.getTurn();
+	state.roll = m.engine.getRoll();
+	return state;
+}
+
+
+
+
+//Queue message for match
+void Worker::broadcast(Match& m, const Message& message){
+	//Encode once for players and spectators
+	Frame frame = Net::frame(message);
+	for(int i = 0; i < PLAYERS; ++i)
+		queue(m.seats[i], frame);
+	for(unsigned i = 0; i < m.watchers.size(); ++i)
+		queue(m.watchers[i], frame);
+}
+
+//Queue message for session
+void Worker::queue(int fd, const Frame& frame){
+	map<int, Session*>::iterator it = mSessions.find(fd);
+	if(it==mSessions.end()) return;
+	Session* s = it->second;
+	if(s->resync) return;
+	//Session does not keep up, replace its backlog by a snapshot later
+	if(s->net.getQueued() > SEND_BACKLOG){
+		s->net.discard();
+		s->resync = 1;
+	}
+	else s->net.send(frame);
+	mPending.insert(fd);
+}
+
+//Write queued data
+void Worker::flushPending(){
+	//Dropping a session can queue more lines
+	while(!mPending.empty()){
+		set<int> pending;
+		pending.swap(mPending);
+		for(set<int>::iterator it = pending.begin(); it!=pending.end(); ++it){
+			map<int, Session*>::iterator session = mSessions.find(*it);
+			if(session==mSessions.end()) continue;
+			Session* s = session->second;
+			if(!s->net.flush()){
+				drop(s);
+				continue;
+			}
+			//Drained session catches up with the current state
+			if(s->resync && !s->net.hasOutput()){
+				s->resync = 0;
+				map<int, Match>::iterator match = mMatches.find(s->match);
+				if(match!=mMatches.end()) s->net.send(snapshot(match->second));
+				if(!s->net.flush()){
+					drop(s);
+					continue;
+				}
+			}
+			//Watch for writability only while data is queued
+			epoll_event e;
+			e.events = EPOLLIN | (s->net.hasOutput() ? EPOLLOUT : 0);
+			e.data.u64 = 0;
+			e.data.fd = *it;
+			epoll_ctl(miEpoll, EPOLL_CTL_MOD, *it, &e);
+		}
+	}
+}
+
+//Close session
+void Worker::drop(Session* s){
+	int fd = s->net.getFd();
+	if(!mSessions.count(fd)) return;
+	release(s);
+	mPending.erase(fd);
+	map<int, Match>::iterator it = mMatches.find(s->match);
+	if(it!=mMatches.end()){
+		Match& m = it->second;
+		if(s->color==NONE) m.watchers.erase(std::remove(m.watchers.begin(), m.watchers.end(), fd), m.watchers.end());
+		else m.seats[s->color-1] = -1;
+		//Close started match
+		if(m.started && s->color!=NONE){
+			Message left(MSG_LEFT);
+			left.color = s->color;
+			broadcast(m, left);
+			for(int i = 0; i < PLAYERS; ++i)
+				if(mSessions.count(m.seats[i])) mSessions[m.seats[i]]->match = -1;
+			for(unsigned i = 0; i < m.watchers.size(); ++i)
+				if(mSessions.count(m.watchers[i])) mSessions[m.watchers[i]]->match = -1;
+			mMatches.erase(it);
+		}
+		//Remove match nobody plays or watches
+		else if(!m.started){
+			bool empty = m.watchers.empty();
+			for(int i = 0; i < PLAYERS; ++i)
+				if(m.seats[i]>=0) empty = 0;
+			if(empty) mMatches.erase(it);
+		}
+	}
+	delete s;
+}
+
+//Stop watching session
+void Worker::release(Session* s){
+	epoll_ctl(miEpoll, EPOLL_CTL_DEL, s->net.getFd(), NULL);
+	mSessions.erase(s->net.getFd());
+}
+
+
+
+
+//Constructor
+Server::Server(int workers, unsigned seed){
+	miSeed = seed;
+	for(int i = 0; i < workers; ++i)
+		mWorkers.push_back(new Worker(*this));
+}
+
+//Destructor
+Server::~Server(){
+	for(unsigned i = 0; i < mWorkers.size(); ++i)
+		delete mWorkers[i];
+}
+
+//Open listeners
+bool Server::listen(const string& address){
+	//Unix sockets cannot share a path, the first worker accepts
+	if(address.find('/')!=string::npos){
+		int fd = Net::listen(address);
+		if(fd<0) return 0;
+		mWorkers[0]->addListener(fd);
+		return 1;
+	}
+	//TCP connections are spread by the kernel over one listener per worker
+	for(unsigned i = 0; i < mWorkers.size(); ++i){
+		int fd = Net::listen(address, 1);
+		if(fd<0) return 0;
+		mWorkers[i]->addListener(fd);
+	}
+	return 1;
+}
+
+//Serve
+void Server::run(){
+	mbRunning = 1;
+	for(unsigned i = 0; i < mWorkers.size(); ++i)
+		mWorkers[i]->start();
+	for(unsigned i = 0; i < mWorkers.size(); ++i)
+		mWorkers[i]->join();
+}
+
+//Stop serving
+void Server::stop(){
+	mbRunning = 0;
+}
+
+//Check if serving
+bool Server::isRunning(){
+	return mbRunning;
+}
+
+//Worker owning a match
+Worker& Server::getOwner(int match){
+	return *mWorkers[(unsigned)match % mWorkers.size()];
+}
+
+//Match RNG seed
+unsigned Server::getSeed(int match) const {
+	return miSeed ^ ((unsigned)match*2654435761u);
+}
@@ -0,0 +1,217 @@
+///Authoritative match server (Linux, epoll)
+
+#ifndef SERVER_H
+#define SERVER_H
+
+///Include local modules
+#include "Engine.h"
+#include "Net.h"
+
+///Misc library inclusion
+#include <atomic>
+#include <map>
+using std::map;
+#include <set>
+using std::set;
+#include <mutex>
+using std::mutex;
+#include <thread>
+using std::thread;
+#include <utility>
+using std::pair;
+
+///Sessions speak the binary protocol from Protocol.h: HELLO, then JOIN, then
+///ROLL_REQUEST / MOVE_REQUEST on their turn. The match is sent as a SNAPSHOT when
+///it starts (or on RESYNC) and as numbered deltas afterwards.
+///Turns with at most one legal move are played by the server.
+///Spectators send WATCH instead of JOIN and only receive. Every delta is encoded
+///once and the same buffer is queued for all sessions of the match; a session
+///more than SEND_BACKLOG bytes behind loses its queued deltas and gets a
+///snapshot once its socket has drained.
+
+///Queued bytes after which a session is resynchronized instead
+#define SEND_BACKLOG 65536
+
+class Server;
+
+///Seats and rules of one match
+struct Match{
+	///Session sockets by color (-1 if the seat is free)
+	int seats[PLAYERS];
+	///Spectator sockets
+	vector<int> watchers;
+	///Flag if all seats were taken
+	bool started;
+	///Sequence number of the last state change
+	unsigned seq;
+	///Match state
+	Engine engine;
+};
+
+///Connected client
+struct Session{
+	///Socket and buffers
+	Connection net;
+	///Joined or watched match (-1 before JOIN / WATCH)
+	int match;
+	///Seat color (NONE for spectators)
+	Colors color;
+	///Flag if the protocol version was accepted
+	bool greeted;
+	///Flag if deltas were dropped and a snapshot is due
+	bool resync;
+};
+
+///Worker thread owning the matches that hash to it
+class Worker{
+public:
+
+	///Constructor
+	///Args:
+	///Server& server - owning server
+	Worker(Server& server);
+
+	///Destructor (closes all sessions)
+	~Worker();
+
+	///Accept connections from a listening socket
+	void addListener(int fd);
+
+	///Give a session to this worker (called from other threads)
+	///Args:
+	///int fd - session socket
+	///const string& input - data read but not handled yet
+	void handOff(int fd, const string& input);
+
+	///Start and wait for the thread
+	void start();
+	void join();
+
+private:
+
+	///Event loop
+	void run();
+
+	///Accept waiting connections
+	void accept(int listener);
+
+	///Take over sessions handed off by other workers
+	void takeHandOffs();
+
+	///Start watching a session
+	void attach(int fd, const string& input);
+
+	///Read and handle session input
+	void receive(Session* s);
+
+	///Handle one command
+	void handle(Session* s, const Message& m);
+
+	///Send an error to a session
+	void refuse(Session* s, ErrorCodes code);
+
+	///Find or create a match
+	Match& getMatch(int id);
+
+	///Seat a session in a match
+	void join(Session* s, int id);
+
+	///Add a spectator to a match
+	void watch(Session* s, int id);
+
+	///Apply a move and announce the changes and the next turn
+	///(returns 0 if the move is not legal)
+	bool move(int id, int pawn);
+
+	///Full state of a match
+	Message snapshot(Match& m);
+
+	///Queue a message for every session in a match
+	void broadcast(Match& m, const Message& message);
+
+	///Queue an encoded message for a session (slow sessions are resynchronized)
+	///Args:
+	///int fd - session socket
+	///const Frame& frame - shared encoded message
+	void queue(int fd, const Frame& frame);
+
+	///Write queued data of pending sessions and update the watched events
+	void flushPending();
+
+	///Close a session (the match is closed if a player left after the start)
+	void drop(Session* s);
+
+	///Stop watching a session without closing it
+	void release(Session* s);
+
+	///Owning server
+	Server& mServer;
+
+	///Epoll and wake up descriptors
+	int miEpoll, miWake;
+
+	///Listening sockets
+	vector<int> mListeners;
+
+	///Sessions by socket
+	map<int, Session*> mSessions;
+
+	///Matches owned by this worker
+	map<int, Match> mMatches;
+
+	///Sessions with queued data
+	set<int> mPending;
+
+	///Sessions waiting for hand off
+	mutex mHandOffLock;
+	vector<pair<int, string> > mHandOffs;
+
+	///Worker thread
+	thread mThread;
+};
+
+class Server{
+public:
+
+	///Constructor
+	///Args:
+	///int workers - worker threads
+	///unsigned seed - RNG seed (each match gets its own)
+	Server(int workers, unsigned seed);
+
+	///Destructor
+	~Server();
+
+	///Listen on an address (before run)
+	///Args:
+	///const string& address - "host:port" or Unix socket path
+	bool listen(const string& address);
+
+	///Serve until stop() is called
+	void run();
+
+	///Stop serving (safe from signal handlers)
+	static void stop();
+
+	///Check if serving
+	static bool isRunning();
+
+	///Worker owning a match
+	Worker& getOwner(int match);
+
+	///RNG seed of a match
+	unsigned getSeed(int match) const;
+
+private:
+
+	///Workers
+	vector<Worker*> mWorkers;
+
+	///Server RNG seed
+	unsigned miSeed;
+
+	///Running flag
+	static std::atomic<bool> mbRunning;
+};
+
+#endif
@@ -0,0 +1,198 @@
+///ludo-server - authoritative match server and stand-in clients
+///Usage:
+///  ludo-server [--listen ADDRESS]... [--workers N] [--seed S]
+///  ludo-server --bots ADDRESS MATCH [COUNT] [WATCHERS]
+
+#include "Server.h"
+
+#include <csignal>
+#include <cstdlib>
+#include <ctime>
+#include <poll.h>
+
+using std::cout;
+
+//Stop on SIGINT / SIGTERM
+static void onSignal(int){
+	Server::stop();
+}
+
+
+
+
+//Stand-in client playing random legal moves
+struct Bot{
+	Connection net;
+	Colors color;
+	Engine replica;
+	unsigned seq;
+	bool done;
+};
+
+//Check a delta against the replica
+static bool matches(const Engine& replica, const Message& m){
+	const vector<PlayerRecord>& players = replica.getPlayers();
+	for(unsigned i = 0; i < players.size(); ++i){
+		if(players[i].color!=m.color) continue;
+		const PawnRecord& pawn = players[i].pawns[m.pawn];
+		return pawn.position==m.state.position && pawn.x==m.state.x && pawn.y==m.state.y;
+	}
+	return 0;
+}
+
+//Play one match with several bots, checking every delta against a local replica
+//(the last bots only watch)
+static int runBots(const string& address, int match, int players, int watchers){
+	vector<Bot*> bots;
+	int count = players+watchers;
+	for(int i = 0; i < count; ++i){
+		bots.push_back(new Bot);
+		bots.back()->color = NONE;
+		bots.back()->seq = 0;
+		bots.back()->done = 0;
+		if(!bots.back()->net.open(address)) return 1;
+		Message hello(MSG_HELLO);
+		hello.value = PROTOCOL_VERSION;
+		bots.back()->net.send(hello);
+		Message join(i<players ? MSG_JOIN : MSG_WATCH);
+		join.value = match;
+		bots.back()->net.send(join);
+	}
+
+	int errors = 0, finished = 0;
+	size_t bytes = 0;
+	while(finished < count){
+		//Wait for input
+		vector<pollfd> fds(count);
+		for(int i = 0; i < count; ++i){
+			bots[i]->net.flush();
+			fds[i].fd = bots[i]->done ? -1 : bots[i]->net.getFd();
+			fds[i].events = POLLIN;
+			fds[i].revents = 0;
+		}
+		if(poll(&fds[0], count, 5000)<=0){
+			cerr << "Bots: server timed out" << endl;
+			return 1;
+		}
+
+		for(int i = 0; i < count; ++i){
+			Bot& b = *bots[i];
+			if(b.done || !fds[i].revents) continue;
+			size_t buffered = b.net.getInput().size();
+			bool open = b.net.receive();
+			if(i==0) bytes += b.net.getInput().size()-buffered;
+			Message m;
+			int result;
+			while(!b.done && (result = b.net.next(m))>0){
+				//Deltas must arrive in sequence
+				if(m.seq && m.type!=MSG_SNAPSHOT && m.seq!=++b.seq){
+					cerr << "Bots: sequence " << m.seq << " after " << b.seq-1 << endl;
+					errors++;
+				}
+				switch(m.type){
+					case MSG_SEAT:
+						b.color = m.color;
+						break;
+					case MSG_SNAPSHOT:
+						b.replica.load(m.players, m.turn, m.roll);
+						b.seq = m.seq;
+						break;
+					case MSG_TURN:
+						if(m.color!=b.replica.getCurrent()){ cerr << "Bots: turn mismatch" << endl; errors++; }
+						if(m.color==b.color) b.net.send(Message(MSG_ROLL_REQUEST));
+						break;
+					case MSG_ROLL: {
+						b.replica.setRoll(m.value);
+						//Pick one of several moves
+						vector<int> moves = b.replica.getMoves();
+						if(m.color==b.color && moves.size()>1){
+							Message move(MSG_MOVE_REQUEST);
+							move.pawn = moves[rand()%moves.size()];
+							b.net.send(move);
+						}
+						break;
+					}
+					case MSG_MOVE:
+						if(!b.replica.move(m.pawn) || (m.pawn!=PASS && !matches(b.replica, m))){
+							cerr << "Bots: replica disagrees with move " << m.seq << endl;
+							errors++;
+						}
+						break;
+					case MSG_CAPTURE:
+						if(!matches(b.replica, m)){ cerr << "Bots: replica disagrees with capture " << m.seq << endl; errors++; }
+						break;
+					case MSG_END:
+					case MSG_LEFT:
+						if(i==0){
+							cout << "Match " << match << ": " << (m.type==MSG_END ? "finished" : "closed")
+							     << " after " << b.replica.getTurn() << " turns, "
+							     << bytes << " bytes (" << bytes/(b.replica.getTurn()+1) << " per turn)" << endl;
+						}
+						if(m.type==MSG_LEFT || !b.replica.isOver()) errors++;
+						b.done = 1;
+						finished++;
+						break;
+					case MSG_ERROR:
+						cerr << "Bots: error " << m.value << endl;
+						errors++;
+						break;
+					default:
+						break;
+				}
+			}
+			if(result<0){
+				cerr << "Bots: malformed message" << endl;
+				return 1;
+			}
+			if(!open && !b.done){
+				cerr << "Bots: connection closed" << endl;
+				return 1;
+			}
+		}
+	}
+
+	for(int i = 0; i < count; ++i) delete bots[i];
+	return errors ? 1 : 0;
+}
+
+
+
+
+int main(int argc, char* argv[]){
+	vector<string> addresses;
+	int workers = thread::hardware_concurrency();
+	unsigned seed = time(0);
+
+	//Read command line options
+	for(int i = 1; i < argc; ++i){
+		string arg = argv[i];
+		if(arg=="--listen" && i+1<argc) addresses.push_back(argv[++i]);
+		else if(arg=="--workers" && i+1<argc) workers = atoi(argv[++i]);
+		else if(arg=="--seed" && i+1<argc) seed = strtoul(argv[++i], NULL, 0);
+		else if(arg=="--bots" && i+2<argc){
+			srand(seed);
+			int count = i+3<argc ? atoi(argv[i+3]) : PLAYERS;
+			int watchers = i+4<argc ? atoi(argv[i+4]) : 0;
+			return runBots(argv[i+1], atoi(argv[i+2]), count, watchers);
+		}
+		else {
+			cerr << "Usage: " << argv[0] << " [--listen ADDRESS]... [--workers N] [--seed S]" << endl
+			     << "       " << argv[0] << " --bots ADDRESS MATCH [COUNT] [WATCHERS]" << endl;
+			return 1;
+		}
+	}
+	if(addresses.empty()) addresses.push_back(":7777");
+	if(workers<1) workers = 1;
+
+	//Open listeners
+	Server server(workers, seed);
+	for(unsigned i = 0; i < addresses.size(); ++i)
+		if(!server.listen(addresses[i])) return 1;
+
+	signal(SIGINT, onSignal);
+	signal(SIGTERM, onSignal);
+	signal(SIGPIPE, SIG_IGN);
+	cout << "ludo-server: " << workers << " workers, seed " << seed << endl;
+	server.run();
+	return 0;
+}
@@ -357,111 +357,17 @@ extern bool quit;
 #define C_GREEN {0,0,255,255}
 #define C_YELLOW {255,255,0,255}
 
-///Player colors
-enum Colors
+///Player colors and state records
+#include "Records.h"
+
+///Game screens (index into SCREEN_COORDS)
+enum Screens
 {
-	NONE = 0, YELLOW, RED, BLUE
+	BLANK = 0, RULES1, RULES2, TITLE, GAME, WIN
 };
+#define SCREENS_NUM 6
 
-extern int WIDTH;
-extern int HEIGHT;
-extern int FIELD_WIDTH;
-extern int FIELD_HEIGHT;
-extern int BOARD_LENGTH;
-extern int BOARD_WIDTH;
-extern int BOARD_HEIGHT;
-extern int SQUARE_SIZE;
-extern int BUTTON_WIDTH;
-extern int BUTTON_HEIGHT;
-extern int FONT_SIZE;
-extern int RULES_WIDTH;
-extern int RULES_HEIGHT;
-
-extern int PLAYERS;
-extern int PAWNS;
-extern int PLAYER_DATA;
-extern int MOVEMENT_DELAY;
-
-extern int PAWN_FRAMES;
-extern float SPRITE_SCALE[];
-
-extern int WIN_X_OFF;
-extern int WIN_Y_OFF;
-extern int WIN_X_DATA;
-extern int WIN_Y_DATA;
-extern int WIN_SHADOW_OFF;
-extern int VERT_OFFSET;
-
-extern int ZERO_X_POS;
-extern int ZERO_Y_POS;
-extern int ZERO_X_INDEX;
-extern int ZERO_Y_INDEX;
-extern int X_OFF;
-extern int Y_OFF;
-
-extern bool MOVEABLE_SQUARES[15][15];
-
-extern pair<int, int> NEXT_SQUARE[15][15];
-extern pair<int, int> SAFE_SQUARES[3][5];
-extern pair<int, int> BASE_SQUARES[3][5];
-
-extern pair<int, int> ACTIVE_SQUARES[];
-extern unsigned START_POS[];
-extern pair<int, int> NEXT_SAFE[];
-extern pair<int, int> IDLE_POS[];
-extern pair<int, int> FINAL_SQUARES[];
-extern pair<int, int> START_SQUARES[];
-extern pair<int, int> ENTRY_SQUARES[];
-extern pair<int, int> PAWN_LAYOUT[];
-extern pair<int, int> SCREEN_COORDS[];
-extern pair<int, int> DICE_POS[];
-
-extern int TITLE_START;
-extern int TITLE_CONTINUE;
-extern int TITLE_QUIT;
-extern int WIN_RESTART;
-extern int WIN_QUIT;
-extern int CONTROLS_SOUND;
-extern int CONTROLS_RULES;
-extern int CONTROLS_QUIT;
-extern int RULES_BACK;
-extern int RULES_NEXT;
-extern int FADE_FACTOR;
-extern int SLIDER_WIDTH;
-extern int SLIDER_HEIGHT;
-extern int KNOB_WIDTH;
-extern int KNOB_HEIGHT;
-
-extern string START_PATH;
-extern string RESTART_PATH;
-extern string CONTINUE_PATH;
-extern string QUIT_PATH;
-extern string SOUND_ON_PATH;
-extern string SOUND_OFF_PATH;
-extern string RULES_PATH;
-extern string SFX_SLIDER_PATH;
-extern string BGM_SLIDER_PATH;
-extern string SLIDER_KNOB_PATH;
-
-extern string FONT_PATH;
-extern string PAWN_PATH;
-extern string DICE_PATH;
-extern string BOARD_PATH;
-extern string SCROLLABLE_PATH;
-extern string WIN_PATH;
-extern string TITLE_PATH;
-extern string HIGHLIGHTER_PATH;
-
-extern string EXPLODE_PATH;
-extern int EXPLODE_WIDTH;
-extern int EXPLODE_HEIGHT;
-extern int EXPLODE_FRAMES;
-extern int EXPLODE_DELAY;
-
-extern string SHOCK_PATH;
-extern int SHOCK_WIDTH;
-extern int SHOCK_HEIGHT;
-extern int SHOCK_FRAMES;
-extern int SHOCK_DELAY;
+///Board, layout and asset constants (generated from Constants.xml)
+#include "Constants.h"
 
 #endif
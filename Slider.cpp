@@ -46,10 +46,9 @@ float Slider::getSliderValue() const {
 bool Slider::eventHandler(SDL_Event & e){
     if(e.type == SDL_MOUSEBUTTONDOWN){
 		if(e.button.button == SDL_BUTTON_LEFT){
-			int x,y;
-			SDL_GetMouseState(&x, &y);
+			int x = e.button.x, y = e.button.y;
 			std::cout << mRange.x << " " << mRange.w << " " << mSize.y << " " << mSize.h << endl;
-			bool state = (x>=mRange.x && x<=mRange.w && y>=mSize.y && y<=mSize.h);
+			bool state = (x>=mRange.x && x<=mRange.w && y>=mSize.y && y<=mSize.y+mSize.h);
 			if(state) mfPosition = mapToSlider(mRange.x, mRange.w, x);
 			return state;
 		}
@@ -6,73 +6,239 @@
  */
 
 #include "Sound.h"
+#include "Resources.h"
+#include "Trace.h"
+#include "pugixml.hpp"
 // massives/arrays that keep the soundeffects and  music
-Mix_Chunk* Sound::Seffects[];
+vector<SoundEntry> Sound::bank;
+map<string, int> Sound::ids;
+int Sound::slots[];
 Mix_Music* Sound::mus[];
+int Sound::currentMusic = -1;
+int Sound::savedVolume = MIX_MAX_VOLUME;
+int Sound::savedMusicVolume = MIX_MAX_VOLUME;
+bool Sound::savedPlaying = false;
+bool Sound::savedPaused = false;
 bool Sound::mute = 0;
+// sound effect cache bookkeeping
+Uint32 Sound::useCounter = 0;
+Uint32 Sound::cachedBytes = 0;
+// voice bookkeeping
+int Sound::voiceSound[];
+int Sound::voicePriority[];
+Uint32 Sound::voiceStart[];
+// sound bank ids of the SEFFECTS values, in enum order
+static const char* SFX_IDS[SFX_NUM] = {
+	"accend", "accend2", "boink", "boink2", "camera", "censor",
+	"click", "DiceRoll", "ding", "drumroll", "explosion", "fuseBomb",
+	"jump", "pop", "SciFi", "punch", "scratch", "taken",
+	"typing", "whisle", "whisleSlide", "whislewind", "whoosh", "orchHit"
+};
+// music files without extension, in mus order
+static const char* BGM_FILES[BGM_NUM] = {
+	"./BGM/menuS",
+	"./BGM/ambient",
+	"./BGM/electric",
+	"./BGM/rock"
+};
+// music formats, compressed ones first
+static const char* BGM_FORMATS[] = { ".ogg", ".mp3", ".wav" };
 
 //empty constructor
 Sound::Sound()
 {
 }
-// load's the sound effects
+// load's the sound bank (the audio device is opened by SDL_Manager)
 bool Sound::load(){
-	bool success = true;
-	if(SDL_Init(SDL_INIT_AUDIO)<0){
-		cerr << "SDL Audio error: " << SDL_GetError() << endl;
-		success = false;
-	}
-	if(Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048)<0){
-		cerr << "Audio error: " << Mix_GetError() << endl;
-		success = false;
-	}
-	Seffects[0] = Mix_LoadWAV("./SFX/accend.wav");
-	Seffects[1] = Mix_LoadWAV("./SFX/accend2.wav");
-	Seffects[2] = Mix_LoadWAV("./SFX/boink.wav");
-	Seffects[3] = Mix_LoadWAV("./SFX/boink2.wav");
-	Seffects[4] = Mix_LoadWAV("./SFX/camera.wav");
-	Seffects[5] = Mix_LoadWAV("./SFX/censor.wav");
-	Seffects[6] = Mix_LoadWAV("./SFX/click.wav");
-	Seffects[7] = Mix_LoadWAV("./SFX/DiceRoll.wav");
-	Seffects[8] = Mix_LoadWAV("./SFX/ding.wav");
-	Seffects[9] = Mix_LoadWAV("./SFX/drumroll.wav");
-	Seffects[10] = Mix_LoadWAV("./SFX/explosion.wav");
-	Seffects[11] = Mix_LoadWAV("./SFX/fuseBomb.wav");
-	Seffects[12] = Mix_LoadWAV("./SFX/jump.wav");
-	Seffects[13] = Mix_LoadWAV("./SFX/pop.wav");
-	Seffects[14] = Mix_LoadWAV("./SFX/SciFi.wav");
-	Seffects[15] = Mix_LoadWAV("./SFX/punch.wav");
-	Seffects[16] = Mix_LoadWAV("./SFX/scratch.wav");
-	Seffects[17] = Mix_LoadWAV("./SFX/taken.wav");
-	Seffects[18] = Mix_LoadWAV("./SFX/typing.wav");
-	Seffects[19] = Mix_LoadWAV("./SFX/whisle.wav");
-	Seffects[20] = Mix_LoadWAV("./SFX/whisleSlide.wav");
-	Seffects[21] = Mix_LoadWAV("./SFX/whislewind.wav");
-	Seffects[22] = Mix_LoadWAV("./SFX/whoosh.wav");
-	Seffects[23] = Mix_LoadWAV("./SFX/orchHit.wav");
+	bool success = loadBank(SOUND_BANK);
 
-	//gives error if  the the sounds effects are NOT loaded correctly.
+	// find the bank entry of every SEFFECTS value
 	for(int i = 0; i < SFX_NUM; ++i){
-		if(Seffects[i]==NULL){
+		map<string, int>::iterator it = ids.find(SFX_IDS[i]);
+		slots[i] = it==ids.end() ? -1 : it->second;
+		if(slots[i]<0)
+			cerr << "Seffects error: " << SFX_IDS[i] << " is not in " << SOUND_BANK << endl;
+	}
+	for(int i = 0; i < BGM_NUM; ++i)
+		mus[i] = NULL;
+
+	// fixed pool of voices, shared by all sound effects
+	Mix_AllocateChannels(VOICES);
+	for(int ch = 0; ch < VOICES; ++ch)
+		voiceSound[ch] = -1;
+
+	// decode the sounds that should always be resident
+	for(unsigned i = 0; i < bank.size(); ++i)
+		if(bank[i].preload && chunk(i)==NULL) success = false;
+
+	return success;
+}
+// reads the sound bank manifest into the table
+bool Sound::loadBank(const char* path){
+	pugi::xml_document doc;
+	pugi::xml_parse_result res = doc.load_file(path);
+	if(!res){
+		cerr << "Sound bank error: " << path << ": " << res.description() << endl;
+		return false;
+	}
+	bank.clear();
+	ids.clear();
+	cachedBytes = 0;
+	for(pugi::xml_node n = doc.child("sounds").child("sound"); n; n = n.next_sibling("sound")){
+		SoundEntry e;
+		e.id = n.attribute("id").as_string();
+		e.path = n.attribute("path").as_string();
+		e.preload = n.attribute("preload").as_bool(false);
+		e.volume = n.attribute("volume").as_int(MIX_MAX_VOLUME);
+		e.voice.priority = n.attribute("priority").as_int(1);
+		e.voice.maxInstances = n.attribute("max").as_int(2);
+		e.voice.cooldown = n.attribute("cooldown").as_uint(0);
+		e.chunk = NULL;
+		e.lastUse = e.lastPlay = 0;
+		e.failed = false;
+		if(e.id.empty() || e.path.empty() || ids.count(e.id)){
+			cerr << "Sound bank error: bad or repeated sound \"" << e.id << "\"" << endl;
+			continue;
+		}
+		ids[e.id] = bank.size();
+		bank.push_back(e);
+	}
+	return true;
+}
+// returns the decoded sound effect, loading it on first use
+Mix_Chunk* Sound::chunk(int i){
+	SoundEntry& e = bank[i];
+	if(e.chunk==NULL){
+		// do not retry files that are missing
+		if(e.failed) return NULL;
+		TRACE_SCOPE("decode sound");
+		Mix_Chunk* loaded = Mix_LoadWAV(e.path.c_str());
+		if(loaded==NULL){
 			cerr << "Seffects error: " << Mix_GetError() << endl;
-			success = false;
+			e.failed = true;
+			return NULL;
+		}
+		Mix_VolumeChunk(loaded, e.volume);
+		// make room for the new sound in the cache
+		evict(loaded->alen);
+		e.chunk = loaded;
+		cachedBytes += loaded->alen;
+		Resources::Scope scope("sound");
+		Resources::add(loaded, RESOURCE_SOUND, e.path, loaded->alen);
+	}
+	e.lastUse = ++useCounter;
+	return e.chunk;
+}
+// frees the least recently used sound effects until the new one fits
+void Sound::evict(Uint32 needed){
+	while(cachedBytes+needed > SFX_CACHE_SIZE){
+		int oldest = -1;
+		for(unsigned i = 0; i < bank.size(); ++i){
+			// preloaded sounds stay resident
+			if(bank[i].chunk==NULL || bank[i].preload || isPlaying(bank[i].chunk)) continue;
+			if(oldest<0 || bank[i].lastUse<bank[oldest].lastUse) oldest = i;
 		}
+		// everything resident is playing, go over the budget for now
+		if(oldest<0) return;
+		cachedBytes -= bank[oldest].chunk->alen;
+		Resources::remove(bank[oldest].chunk);
+		Mix_FreeChunk(bank[oldest].chunk);
+		bank[oldest].chunk = NULL;
+	}
+}
+// checks if a sound effect is playing on any channel
+bool Sound::isPlaying(Mix_Chunk* c){
+	int channels = Mix_AllocateChannels(-1);
+	for(int ch = 0; ch < channels; ++ch)
+		if(Mix_Playing(ch) && Mix_GetChunk(ch)==c) return true;
+	return false;
+}
+// plays a sound effect on a pooled voice
+void Sound::start(int i){
+	Uint32 now = SDL_GetTicks();
+	SoundEntry& e = bank[i];
+	const SoundVoice& v = e.voice;
+	// skip retriggers that come too soon
+	if(e.lastPlay && now-e.lastPlay < v.cooldown) return;
+
+	// count running instances and find the oldest one
+	int instances = 0, oldestInstance = -1;
+	for(int ch = 0; ch < VOICES; ++ch){
+		if(!Mix_Playing(ch) || voiceSound[ch]!=i) continue;
+		instances++;
+		if(oldestInstance<0 || voiceStart[ch]<voiceStart[oldestInstance]) oldestInstance = ch;
 	}
 
-	mus[0] = Mix_LoadMUS("./BGM/menuS.mp3");
-	mus[1] = Mix_LoadMUS("./BGM/ambient.wav");
-	mus[2] = Mix_LoadMUS("./BGM/electric.wav");
-	mus[3] = Mix_LoadMUS("./BGM/rock.wav");
-	
-	//gives error if  the the music is NOT loaded correctly.
-	for(int i = 0; i < BGM_NUM; ++i){
-			if(mus[i]==NULL){
-				cerr << "music error: " << Mix_GetError() << endl;
-				success = false;
-			}
+	int voice = -1;
+	// restart the oldest instance if the sound is at its limit
+	if(instances >= v.maxInstances) voice = oldestInstance;
+	// otherwise take a free voice
+	for(int ch = 0; ch < VOICES && voice<0; ++ch)
+		if(!Mix_Playing(ch)) voice = ch;
+	// otherwise steal the oldest voice of the lowest priority not above ours
+	if(voice<0){
+		for(int ch = 0; ch < VOICES; ++ch){
+			if(voicePriority[ch] > v.priority) continue;
+			if(voice<0 || voicePriority[ch]<voicePriority[voice]
+			   || (voicePriority[ch]==voicePriority[voice] && voiceStart[ch]<voiceStart[voice]))
+				voice = ch;
 		}
-	
-	return success;
+		// every voice plays something more important
+		if(voice<0) return;
+	}
+
+	Mix_Chunk* c = chunk(i);
+	if(c==NULL) return;
+	Mix_HaltChannel(voice);
+	if(Mix_PlayChannel(voice, c, 0)<0) return;
+	voiceSound[voice] = i;
+	voicePriority[voice] = v.priority;
+	voiceStart[voice] = now;
+	e.lastPlay = now;
+}
+// opens a music track for streaming, the other tracks are closed
+Mix_Music* Sound::track(int i){
+	if(mus[i]==NULL){
+		for(int j = 0; j < BGM_NUM; ++j){
+			if(mus[j]==NULL) continue;
+			Mix_FreeMusic(mus[j]);
+			mus[j] = NULL;
+		}
+		TRACE_SCOPE("decode music");
+		// use the first format the track exists in
+		for(unsigned f = 0; f < sizeof(BGM_FORMATS)/sizeof(BGM_FORMATS[0]) && mus[i]==NULL; ++f)
+			mus[i] = Mix_LoadMUS((string(BGM_FILES[i])+BGM_FORMATS[f]).c_str());
+		//gives error if  the the music is NOT loaded correctly.
+		if(mus[i]==NULL)
+			cerr << "music error: " << Mix_GetError() << endl;
+	}
+	return mus[i];
+}
+// stops all sound before the audio device is reopened
+void Sound::suspend(){
+	savedVolume = Mix_Volume(-1, -1);
+	savedMusicVolume = Mix_VolumeMusic(-1);
+	savedPlaying = Mix_PlayingMusic();
+	savedPaused = Mix_PausedMusic();
+	Mix_HaltChannel(-1);
+	Mix_HaltMusic();
+	// music is opened again for the new device
+	for (int i = 0; i < BGM_NUM; i++) {
+		Mix_FreeMusic(mus[i]);
+		mus[i] = NULL;
+	}
+}
+// restores voices, volumes and music after the device is reopened
+void Sound::resume(){
+	Mix_AllocateChannels(VOICES);
+	for(int ch = 0; ch < VOICES; ++ch)
+		voiceSound[ch] = -1;
+	Mix_Volume(-1, savedVolume);
+	if(savedPlaying && currentMusic>=0){
+		Mix_PlayMusic(track(currentMusic), -1);
+		if(savedPaused) Mix_PauseMusic();
+	}
+	Mix_VolumeMusic(savedMusicVolume);
 }
 //pauses the music
 void Sound::pause() {
@@ -84,96 +250,65 @@ bool Sound::playing() {
 }
 // frees/clear's the  used memory that the sounds used
 void Sound::free(){
-	for (int i = 0; i < SFX_NUM; i++) {
-		Mix_FreeChunk(Seffects[i]);
-		Seffects[i] = NULL;
+	for (unsigned i = 0; i < bank.size(); i++) {
+		Resources::remove(bank[i].chunk);
+		Mix_FreeChunk(bank[i].chunk);
+		bank[i].chunk = NULL;
 	}
+	cachedBytes = 0;
 	// frees/clear's the  used memory that the music used
 	for (int i = 0; i < BGM_NUM; i++) {
 		Mix_FreeMusic(mus[i]);
 		mus[i] = NULL;
 	}
 }
+#ifdef HOT_RELOAD
+// reloads a sound effect whose file has changed
+void Sound::reload(string file){
+	for(unsigned i = 0; i < bank.size(); ++i){
+		SoundEntry& e = bank[i];
+		string path = e.path;
+		if(path.compare(0, 2, "./")==0) path = path.substr(2);
+		if(path!=file) continue;
+		// a sound that is not resident is read again on next use
+		e.failed = false;
+		if(e.chunk==NULL) continue;
+		Mix_Chunk* loaded = Mix_LoadWAV(e.path.c_str());
+		// keeps the old sound if the new file does not load
+		if(loaded==NULL){
+			cerr << "Seffects error: " << Mix_GetError() << endl;
+			continue;
+		}
+		Mix_VolumeChunk(loaded, e.volume);
+		cachedBytes += loaded->alen;
+		cachedBytes -= e.chunk->alen;
+		Resources::remove(e.chunk);
+		Mix_FreeChunk(e.chunk);
+		e.chunk = loaded;
+		Resources::Scope scope("sound");
+		Resources::add(loaded, RESOURCE_SOUND, e.path, loaded->alen);
+	}
+}
+#endif
 // Mothod that plays  the sound effects
 void Sound::play(SEFFECTS sound)
 {
-	if(!mute){
-		switch(sound){
-			case accend:
-				Mix_PlayChannel(-1, Seffects[0], 0);
-				break;
-			case accend2:
-					Mix_PlayChannel(-1, Seffects[1], 0);
-				break;
-			case boink:
-				Mix_PlayChannel(-1, Seffects[2], 0);
-				break;
-			case boink2:
-				Mix_PlayChannel(-1, Seffects[3], 0);
-				break;
-			case camera:
-				Mix_PlayChannel(-1, Seffects[4], 0);
-					break;
-			case censor:
-				Mix_PlayChannel(-1, Seffects[5], 0);
-				break;
-			case click:
-				Mix_PlayChannel(-1, Seffects[6], 0);
-				break;
-			case DiceRoll:
-				Mix_PlayChannel(-1, Seffects[7], 0);
-				break;
-			case ding:
-				Mix_PlayChannel(-1, Seffects[8], 0);
-				break;
-			case drumroll:
-				Mix_PlayChannel(-1, Seffects[9], 0);
-				break;
-			case explosion:
-				Mix_PlayChannel(-1, Seffects[10], 0);
-				break;
-			case fuseBomb:
-				Mix_PlayChannel(-1, Seffects[11], 0);
-				break;
-			case jump:
-				Mix_PlayChannel(-1, Seffects[12], 0);
-				break;
-			case pop:
-				Mix_PlayChannel(-1, Seffects[13], 0);
-				break;
-			case punch:
-				Mix_PlayChannel(-1, Seffects[14], 0);
-					break;
-			case SciFi:
-				Mix_PlayChannel(-1, Seffects[15], 0);
-				break;
-			case scratch:
-				Mix_PlayChannel(-1, Seffects[16], 0);
-				break;
-			case taken:
-				Mix_PlayChannel(-1, Seffects[17], 0);
-				break;
-			case typing:
-				Mix_PlayChannel(-1, Seffects[18], 0);
-				break;
-			case whisle:
-				Mix_PlayChannel(-1, Seffects[19], 0);
-				break;
-			case whisleSlide:
-				Mix_PlayChannel(-1, Seffects[20], 0);
-					break;
-			case whislewind:
-				Mix_PlayChannel(-1, Seffects[21], 0);
-				break;
-			case whoosh:
-				Mix_PlayChannel(-1, Seffects[22], 0);
-				break;
-			case orchHit:
-				Mix_PlayChannel(-1, Seffects[23], 0);
-				break;
-			}
-		}
+	TRACE_SCOPE("Sound::play");
+	if(!mute && slots[sound]>=0)
+		start(slots[sound]);
+}
+// plays a sound effect by its id in the sound bank
+void Sound::play(const string& id)
+{
+	TRACE_SCOPE("Sound::play");
+	map<string, int>::iterator it = ids.find(id);
+	if(it==ids.end()){
+		cerr << "Seffects error: " << id << " is not in " << SOUND_BANK << endl;
+		return;
 	}
+	if(!mute)
+		start(it->second);
+}
 // method that plays the music
 void Sound::music(MUSIC music){
 	if(!mute){
@@ -182,18 +317,19 @@ void Sound::music(MUSIC music){
 			Mix_ResumeMusic();
 		}else {
 		Mix_VolumeMusic(64);
+		currentMusic = music;
 		switch(music){
 			case menuS:
-				Mix_PlayMusic(mus[0], -1);
+				Mix_PlayMusic(track(0), -1);
 				break;
 			case ambient:
-				Mix_PlayMusic(mus[1], -1);
+				Mix_PlayMusic(track(1), -1);
 				break;
 			case electric:
-				Mix_PlayMusic(mus[2], -1);
+				Mix_PlayMusic(track(2), -1);
 				break;
 			case rock:
-				Mix_PlayMusic(mus[3], -1);
+				Mix_PlayMusic(track(3), -1);
 				break;
 		}
 		}
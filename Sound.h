@@ -10,19 +10,55 @@
 
 #define SFX_NUM 24
 #define BGM_NUM 4
+/// most decoded sound effect data kept in memory (bytes)
+#define SFX_CACHE_SIZE (4*1024*1024)
+/// mixer channels shared by all sound effects
+#define VOICES 16
+/// sound bank manifest
+#define SOUND_BANK "./Sounds.xml"
 
 #include <iostream>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_mixer.h>
+#include <vector>
+#include <map>
 using std::cerr;
 using std::endl;
-///  sorted sound effects
+using std::string;
+using std::vector;
+using std::map;
+///  sorted sound effects (named like their ids in the sound bank)
 enum SEFFECTS {accend,accend2,boink,boink2,camera,censor,click,DiceRoll
 ,ding,drumroll,explosion,fuseBomb,jump,pop,SciFi,punch,scratch,taken,
 typing,whisle,whisleSlide,whislewind,whoosh,orchHit
 };
 ///  sorted music  effects
 enum MUSIC{menuS,ambient,electric,rock};
+/// how a sound effect competes for voices
+struct SoundVoice {
+	/// higher priority sounds can take voices from lower ones
+	int priority;
+	/// most instances of the sound playing at once
+	int maxInstances;
+	/// shortest time between two starts of the sound (ms)
+	Uint32 cooldown;
+};
+/// one sound effect of the sound bank
+struct SoundEntry {
+	string id;
+	string path;
+	/// decode at startup and keep resident
+	bool preload;
+	/// default volume (0-128)
+	int volume;
+	SoundVoice voice;
+	/// decoded sound, NULL until first use
+	Mix_Chunk* chunk;
+	/// last use (higher is newer) and last start
+	Uint32 lastUse, lastPlay;
+	/// the file could not be loaded
+	bool failed;
+};
 
 class Sound {
 public:
@@ -35,12 +71,50 @@ public:
 	static bool playing();
 	static void free();
 	static void play(SEFFECTS sound);
+	/// plays a sound effect by its id in the sound bank
+	static void play(const string& id);
 	static void music(MUSIC music);
+	/// stops all sound before the audio device is reopened
+	static void suspend();
+	/// restores voices, volumes and music after the device is reopened
+	static void resume();
+#ifdef HOT_RELOAD
+	/// reloads a changed sound effect file (path like "SFX/click.wav")
+	static void reload(string file);
+#endif
 	virtual ~Sound();
 private:
-	/// static massives/arrays that can be accessed by static methods.
-	static Mix_Chunk* Seffects[SFX_NUM];
+	/// reads the sound bank manifest into the table
+	static bool loadBank(const char* path);
+	/// all sound effects of the sound bank, indexed by bank order
+	static vector<SoundEntry> bank;
+	/// bank index of every id
+	static map<string, int> ids;
+	/// bank index of every SEFFECTS value (-1 if it is not in the bank)
+	static int slots[SFX_NUM];
 	static Mix_Music* mus[BGM_NUM];
+	/// last started music track (-1 if none)
+	static int currentMusic;
+	/// state kept while the audio device is reopened
+	static int savedVolume, savedMusicVolume;
+	static bool savedPlaying, savedPaused;
+	static Uint32 useCounter;
+	/// decoded sound effect data in memory (bytes)
+	static Uint32 cachedBytes;
+	/// returns the decoded sound effect, loading it on first use
+	static Mix_Chunk* chunk(int i);
+	/// frees least recently used sound effects to make room
+	static void evict(Uint32 needed);
+	/// checks if a sound effect is playing on any channel
+	static bool isPlaying(Mix_Chunk* c);
+	/// opens a music track for streaming, closing the others
+	static Mix_Music* track(int i);
+	/// plays a sound effect on a pooled voice
+	static void start(int i);
+	/// sound effect, priority and start time of every voice
+	static int voiceSound[VOICES];
+	static int voicePriority[VOICES];
+	static Uint32 voiceStart[VOICES];
 };
 
 #endif /* SOUND_H_ */
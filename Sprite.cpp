@@ -4,7 +4,7 @@ Sprite::Sprite(SDL_Rect frameSize, Uint32 numOfFrames, Uint32 animationDelay){
 	//Initialize data
 	setNumOfFrames(numOfFrames);
 	setAnimationDelay(animationDelay);
-	miAnimationTimer = SDL_GetTicks();
+	miAnimationTimer = Clock::now();
 	miCurrentFrame = 0;
 
 	//Initialize animation frame
@@ -32,7 +32,7 @@ void Sprite::setAnimationFrame(SDL_Rect animationFrame){
 
 void Sprite::render(int x, int y, double s, SDL_Rect* clip, double a, SDL_Point* c, SDL_RendererFlip f){
 	//If enough time has passed
-	if(SDL_GetTicks()-miAnimationTimer > miAnimationDelay){
+	if(Clock::now()-miAnimationTimer > miAnimationDelay){
 		//If we are not on the last frame
 		if(miCurrentFrame < miNumOfFrames-1){
 			//If spritesheet row end has not been reached
@@ -56,7 +56,7 @@ void Sprite::render(int x, int y, double s, SDL_Rect* clip, double a, SDL_Point*
 			miCurrentFrame = 0;
 		}
 		//Restart animation timer
-		miAnimationTimer = SDL_GetTicks();
+		miAnimationTimer = Clock::now();
 	}
 
 	//Render part of sprite
@@ -74,6 +74,20 @@ void Sprite::render(int x, int y, double s, SDL_Rect* clip, double a, SDL_Point*
 
 }
 
+void Sprite::renderFrame(int x, int y, Uint32 frame){
+	//Start from the first frame
+	SDL_Rect clip = {(int)miInitX, (int)miInitY, mAnimationFrame.w, mAnimationFrame.h};
+	//Step through the spritesheet the same way render() does
+	for(Uint32 i = 0; i < frame%miNumOfFrames; ++i){
+		if(clip.x+clip.w < getWidth()) clip.x+=clip.w;
+		else {
+			clip.x = 0;
+			clip.y+=clip.h;
+		}
+	}
+	Texture::render(x,y,1,&clip);
+}
+
 Sprite::~Sprite(){
 }
 
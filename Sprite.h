@@ -5,6 +5,7 @@
 
 ///Include inheritance base class
 #include "Texture.h"
+#include "Clock.h"
 
 class Sprite : public Texture{
 public:
@@ -43,6 +44,13 @@ public:
 	///SDL_RendererFlip f - SDL renderer flip flag
 	virtual void render(int x, int y, double s = 1, SDL_Rect* clip = NULL, double a = 0, SDL_Point* c = NULL, SDL_RendererFlip f = SDL_FLIP_NONE);
 
+	///Render a given animation frame (ignores the animation timer)
+	///Args:
+	///int x - X screen coordinate
+	///int y - Y screen coordinate
+	///Uint32 frame - frame index (wraps around)
+	void renderFrame(int x, int y, Uint32 frame);
+
 	///Destructor
 	virtual ~Sprite();
 
@@ -0,0 +1,90 @@
+#include "Strategy.h"
+
+#include <cstdlib>
+#include <sstream>
+
+//Feature names used in configurations
+static const char* FEATURE_NAMES[FEATURES] = {"capture", "progress", "enter", "finish", "lead"};
+
+//Constructor
+Strategy::Strategy(){
+	mName = "random";
+	for(int i = 0; i < FEATURES; ++i) mfWeights[i] = 0;
+}
+
+//Read configuration
+bool Strategy::parse(const string& line){
+	std::istringstream in(line);
+	if(!(in >> mName)) return 0;
+	string item;
+	while(in >> item){
+		size_t equals = item.find('=');
+		string name = item.substr(0, equals);
+		int feature = 0;
+		while(feature < FEATURES && name!=FEATURE_NAMES[feature]) feature++;
+		if(feature==FEATURES || equals==string::npos) return 0;
+		char* end;
+		string value = item.substr(equals+1);
+		mfWeights[feature] = strtod(value.c_str(), &end);
+		if(value.empty() || *end!='\0') return 0;
+	}
+	return 1;
+}
+
+
+
+
+//Pick move
+int Strategy::pick(const Engine& engine, const vector<int>& moves, std::minstd_rand& random) const {
+	const PlayerRecord& before = engine.getPlayers().front();
+	int furthest = 0;
+	for(unsigned i = 0; i < before.pawns.size(); ++i)
+		if(before.pawns[i].position>furthest) furthest = before.pawns[i].position;
+
+	vector<int> best;
+	double bestScore = 0;
+	for(unsigned i = 0; i < moves.size(); ++i){
+		//State after the move (the mover is last in turn order unless it rolled a 6)
+		Engine next = engine;
+		next.move(moves[i]);
+		const vector<PlayerRecord>& players = next.getPlayers();
+		const PlayerRecord* after = &players.front();
+		for(unsigned j = 0; j < players.size(); ++j)
+			if(players[j].color==before.color) after = &players[j];
+		const PawnRecord& from = before.pawns[moves[i]];
+		const PawnRecord& to = after->pawns[moves[i]];
+
+		double features[FEATURES];
+		features[FEATURE_CAPTURE] = after->taken-before.taken;
+		features[FEATURE_PROGRESS] = after->steps-before.steps;
+		features[FEATURE_ENTER] = from.position==0;
+		features[FEATURE_FINISH] = to.x==FINAL_SQUARES[before.color-1].first && to.y==FINAL_SQUARES[before.color-1].second;
+		features[FEATURE_LEAD] = from.position>0 && from.position==furthest;
+		double score = 0;
+		for(int f = 0; f < FEATURES; ++f) score += mfWeights[f]*features[f];
+
+		if(best.empty() || score>bestScore){
+			best.assign(1, moves[i]);
+			bestScore = score;
+		}
+		else if(score==bestScore) best.push_back(moves[i]);
+	}
+	return best[random()%best.size()];
+}
+
+
+
+
+//Getters
+const string& Strategy::getName() const {
+	return mName;
+}
+
+//Configuration line
+string Strategy::describe() const {
+	std::ostringstream out;
+	out << mName;
+	for(int i = 0; i < FEATURES; ++i)
+		if(mfWeights[i]) out << " " << FEATURE_NAMES[i] << "=" << mfWeights[i];
+	return out.str();
+}
@@ -0,0 +1,61 @@
+///Move choice of headless bots (no SDL, used by ludo-tournament)
+
+#ifndef STRATEGY_H
+#define STRATEGY_H
+
+///Include local modules
+#include "Engine.h"
+
+///Misc library inclusion
+#include <random>
+#include <string>
+using std::string;
+
+///Scored features of a move
+enum Features{
+	FEATURE_CAPTURE = 0, ///opponent pawns sent back to base
+	FEATURE_PROGRESS,    ///squares advanced
+	FEATURE_ENTER,       ///pawn brought out of base
+	FEATURE_FINISH,      ///pawn reached the final square
+	FEATURE_LEAD,        ///moved pawn was the furthest one
+	FEATURES
+};
+
+///Bot configuration: every legal move is scored by the weighted features of
+///the state it leads to, the best one is played (ties are broken at random,
+///so a bot without weights plays random legal moves)
+class Strategy{
+public:
+
+	///Constructor (random bot)
+	Strategy();
+
+	///Read a configuration line "NAME [FEATURE=WEIGHT]..."
+	///(returns 0 on unknown features or bad weights)
+	///Args:
+	///const string& line - configuration
+	bool parse(const string& line);
+
+	///Pick one of the legal moves of the current player
+	///Args:
+	///const Engine& engine - rolled match state
+	///const vector<int>& moves - legal moves (not empty)
+	///std::minstd_rand& random - tie breaking RNG
+	int pick(const Engine& engine, const vector<int>& moves, std::minstd_rand& random) const;
+
+	///Getters
+	const string& getName() const;
+
+	///Configuration line (name and non-zero weights)
+	string describe() const;
+
+private:
+
+	///Bot name
+	string mName;
+
+	///Feature weights
+	double mfWeights[FEATURES];
+};
+
+#endif
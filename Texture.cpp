@@ -1,22 +1,47 @@
 #include "Texture.h"
+#include "Profiler.h"
+#include "Resources.h"
+#include "Trace.h"
 
 SDL_Renderer* Texture::mRenderer = NULL;
 
+#ifdef HOT_RELOAD
+set<Texture*>& Texture::loaded(){
+	static set<Texture*>* registered = new set<Texture*>;
+	return *registered;
+}
+#endif
+
 Texture::Texture(){
 	//Initialize data
 	initData();
 }
 
 void Texture::load(string path){
+	TRACE_SCOPE("Texture::load");
+#ifdef HOT_RELOAD
+	//Remember source file for reloading
+	mPath = path;
+	loaded().insert(this);
+
+	//Keep the old texture until the new one has loaded
+	SDL_Texture* old = mTexture;
+#else
 	//Free old texture
+	Resources::remove(mTexture);
 	SDL_DestroyTexture(mTexture);
+#endif
 	mTexture = NULL;
 	
 	//Create blank texture
 	SDL_Texture* board;
 	
 	//Load image to surface
-	SDL_Surface* loaded = IMG_Load(path.c_str());
+	SDL_Surface* loaded;
+	{
+		TRACE_SCOPE("decode image");
+		loaded = IMG_Load(path.c_str());
+	}
 	
 	//Integrity check
 	if(loaded==NULL){
@@ -24,6 +49,7 @@ void Texture::load(string path){
 	} else {
 		//Create texture from loaded surface
 		board = SDL_CreateTextureFromSurface(mRenderer, loaded);
+		Profiler::count(COUNT_UPLOADS);
 		//Integrity check
 		if(board==NULL) {
 			cerr << "Texture error: " << SDL_GetError() << endl;
@@ -33,14 +59,41 @@ void Texture::load(string path){
 			//Set texture dimensions
 			mWidth = loaded->w;
 			mHeight = loaded->h;
+			Resources::add(mTexture, RESOURCE_TEXTURE, path, Resources::textureBytes(mTexture));
 		}
 		//Release surface data
 		SDL_FreeSurface(loaded);
 	}
+
+#ifdef HOT_RELOAD
+	if(old!=NULL){
+		//Keep the old texture if loading failed
+		if(mTexture==NULL) mTexture = old;
+		else {
+			//Carry modulation over to the new texture
+			Uint8 r, g, b, a;
+			SDL_BlendMode m;
+			SDL_GetTextureColorMod(old, &r, &g, &b);
+			SDL_GetTextureAlphaMod(old, &a);
+			SDL_GetTextureBlendMode(old, &m);
+			SDL_SetTextureColorMod(mTexture, r, g, b);
+			SDL_SetTextureAlphaMod(mTexture, a);
+			SDL_SetTextureBlendMode(mTexture, m);
+			Resources::remove(old);
+			SDL_DestroyTexture(old);
+		}
+	}
+#endif
 }
 
 //Text loading method
 void Texture::textLoad(string s, TTF_Font* f, SDL_Color c){
+	//Free old texture
+	Resources::remove(mTexture);
+	SDL_DestroyTexture(mTexture);
+	mTexture = NULL;
+	Profiler::count(COUNT_TEXT);
+
 	//Load text into surface
 	SDL_Surface* loaded = TTF_RenderText_Solid(f, s.c_str(), c);
 	//Integrity check
@@ -49,6 +102,7 @@ void Texture::textLoad(string s, TTF_Font* f, SDL_Color c){
 	} else {
 		//Create texture from surface
 		mTexture = SDL_CreateTextureFromSurface(mRenderer, loaded);
+		Profiler::count(COUNT_UPLOADS);
 		//Integrity check
 		if(mTexture==NULL) {
 			cerr << "Texture error: " << SDL_GetError() << endl;
@@ -56,6 +110,7 @@ void Texture::textLoad(string s, TTF_Font* f, SDL_Color c){
 			//Get text dimensions
 			mWidth = loaded->w;
 			mHeight = loaded->h;
+			Resources::add(mTexture, RESOURCE_TEXT, "text", Resources::textureBytes(mTexture));
 		}
 		//Release surface data
 		SDL_FreeSurface(loaded);
@@ -84,6 +139,7 @@ void Texture::render(int x, int y, double s, SDL_Rect * clip, double a, SDL_Poin
 	}
 	//Render image
 	SDL_RenderCopyEx(mRenderer, mTexture, clip, &renderQuad, a, c, f);
+	Profiler::count(COUNT_DRAWS);
 }
 
 int Texture::getWidth() const {
@@ -95,9 +151,25 @@ int Texture::getHeight() const {
 }
 
 void Texture::free(){
-	//Release texture data
+	//Release texture data (a second call does nothing)
+	Resources::remove(mTexture);
 	SDL_DestroyTexture(mTexture);
+	mTexture = NULL;
+}
+
+#ifdef HOT_RELOAD
+//Strip leading "./" from a path
+static string normalize(const string& path){
+	return path.compare(0, 2, "./")==0 ? path.substr(2) : path;
+}
+
+void Texture::reload(string path, string newPath){
+	set<Texture*>& all = loaded();
+	for(set<Texture*>::iterator it = all.begin(); it!=all.end(); ++it)
+		if(normalize((*it)->mPath)==normalize(path))
+			(*it)->load(newPath);
 }
+#endif
 
 void Texture::initData(){
 	mTexture = NULL;
@@ -106,5 +178,8 @@ void Texture::initData(){
 }
 
 Texture::~Texture(){
+#ifdef HOT_RELOAD
+	loaded().erase(this);
+#endif
 	free();
 }
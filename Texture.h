@@ -11,6 +11,10 @@
 using std::cerr;
 using std::endl;
 using std::string;
+#ifdef HOT_RELOAD
+#include <set>
+using std::set;
+#endif
 
 class Texture{
 public:
@@ -72,6 +76,14 @@ public:
 	///SDL renderer pointer
 	static SDL_Renderer* mRenderer;
 
+#ifdef HOT_RELOAD
+	///Reload every texture loaded from a file
+	///Args:
+	///string path - file the textures were loaded from
+	///string newPath - file to load them from now
+	static void reload(string path, string newPath);
+#endif
+
 private:
 
 	///SDL tecture pointer
@@ -82,6 +94,15 @@ private:
 	
 	///Texture and dimension initializer
 	void initData();
+
+#ifdef HOT_RELOAD
+	///Loaded image path
+	string mPath;
+
+	///Textures loaded from files (never destroyed, static textures are destroyed
+	///after the statics of this file)
+	static set<Texture*>& loaded();
+#endif
 };
 
 #endif
@@ -0,0 +1,50 @@
+#include "Timeline.h"
+
+//Constructor
+Timeline::Timeline(){
+}
+
+//Track queueing
+void Timeline::add(Uint32 duration, bool blocking, Renderer draw, TrackLayers layer, Callback done, Uint32 offset){
+	Track t = {Clock::now()+offset, duration, blocking, draw, layer, done};
+	mTracks.push_back(t);
+}
+
+//Expired track removal
+void Timeline::update(){
+	Uint32 now = Clock::now();
+	//Collect finished tracks first, callbacks may queue new ones
+	vector<Callback> finished;
+	for(unsigned i = 0; i < mTracks.size(); ){
+		if(now >= mTracks[i].start && now-mTracks[i].start >= mTracks[i].duration){
+			if(mTracks[i].done) finished.push_back(mTracks[i].done);
+			mTracks.erase(mTracks.begin()+i);
+		}
+		else ++i;
+	}
+	for(unsigned i = 0; i < finished.size(); ++i)
+		finished[i]();
+}
+
+//Layer drawing
+void Timeline::render(TrackLayers layer){
+	Uint32 now = Clock::now();
+	for(unsigned i = 0; i < mTracks.size(); ++i){
+		const Track& t = mTracks[i];
+		//Skip tracks of other layers and tracks that have not started
+		if(t.layer!=layer || !t.draw || now < t.start) continue;
+		t.draw(now-t.start);
+	}
+}
+
+//Blocking check
+bool Timeline::isBlocking() const {
+	for(unsigned i = 0; i < mTracks.size(); ++i)
+		if(mTracks[i].blocking) return 1;
+	return 0;
+}
+
+//Track removal
+void Timeline::clear(){
+	mTracks.clear();
+}
@@ -0,0 +1,73 @@
+///Timed effect scheduler
+
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+///Include local modules
+#include "Shared.h"
+#include "Clock.h"
+
+///Misc library inclusion
+#include <functional>
+using std::function;
+#include <vector>
+using std::vector;
+
+///Track drawing layers
+enum TrackLayers{
+	UNDER_DICE=0, OVER_DICE, TRACK_LAYERS
+};
+
+class Timeline{
+public:
+
+	///Track drawing function (gets time since track start in ms)
+	typedef function<void(Uint32)> Renderer;
+
+	///Track completion function
+	typedef function<void()> Callback;
+
+	///Constructor
+	Timeline();
+
+	///Queue a track
+	///Args:
+	///Uint32 duration - track length (in ms)
+	///bool blocking - game logic waits for the track to finish
+	///Renderer draw - drawing function (not required)
+	///TrackLayers layer - drawing layer (not required)
+	///Callback done - called once the track has finished (not required)
+	///Uint32 offset - start delay from now (in ms, not required)
+	void add(Uint32 duration, bool blocking, Renderer draw = Renderer(), TrackLayers layer = OVER_DICE,
+	         Callback done = Callback(), Uint32 offset = 0);
+
+	///Finish expired tracks (called once per frame)
+	void update();
+
+	///Draw running tracks of a layer
+	///Args:
+	///TrackLayers layer - drawing layer
+	void render(TrackLayers layer);
+
+	///Check if a blocking track is queued
+	bool isBlocking() const;
+
+	///Drop all tracks without completing them
+	void clear();
+
+private:
+
+	///Queued track
+	struct Track{
+		Uint32 start, duration;
+		bool blocking;
+		Renderer draw;
+		TrackLayers layer;
+		Callback done;
+	};
+
+	///Queued tracks
+	vector<Track> mTracks;
+};
+
+#endif
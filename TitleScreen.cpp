@@ -10,15 +10,19 @@
 //empty constructor
 TitleScreen::TitleScreen() {
 	canContinue = 0;
+	hasSummary = 0;
 }
 //empty destructor
 TitleScreen::~TitleScreen() {
 	// TODO Auto-generated destructor stub
 }
 
-//Set continue flag
-void TitleScreen::setContinue(bool canContinue){
+//Set continue flag and saved game summary
+void TitleScreen::setContinue(bool canContinue, string summary){
 	this->canContinue = canContinue;
+	//Load summary text if a font is available
+	hasSummary = (summary!=string() && getFont()!=NULL);
+	if(hasSummary) Summary.textLoad(summary, getFont(), C_WHITE);
 }
 
 //handles the event - > when a button is pressed to
@@ -27,11 +31,9 @@ int TitleScreen::eventHandler(SDL_Event& e) {
 	int ButtonState=0;
 	//if enough time has passed
 	if(UI::debounce()){
-		ButtonState|=StartButton.isClicked(e);
-		ButtonState<<=1;
-		ButtonState|=(ContinueButton.isClicked(e)&&canContinue);
-		ButtonState<<=1;
-		ButtonState|=QuitButton.isClicked(e);
+		ButtonState = UI::clicked(e);
+		//continue only works with a saved game
+		if(ButtonState==TITLE_CONTINUE && !canContinue) ButtonState = 0;
 	}
 	return ButtonState;
 
@@ -65,11 +67,17 @@ void TitleScreen::init() {
 	StartButton.setLocation((WIDTH-BUTTON_WIDTH)/2,HEIGHT-VERT_OFFSET-BUTTON_HEIGHT*4);
 	ContinueButton.setLocation((WIDTH-BUTTON_WIDTH)/2,HEIGHT-VERT_OFFSET-BUTTON_HEIGHT*3);
 	QuitButton.setLocation((WIDTH-BUTTON_WIDTH)/2,HEIGHT-VERT_OFFSET);
+
+	//register the buttons for hit testing
+	UI::addButton(StartButton, TITLE_START);
+	UI::addButton(ContinueButton, TITLE_CONTINUE);
+	UI::addButton(QuitButton, TITLE_QUIT);
 }
 // render function that draws the image on the screen
 void TitleScreen::render() {
 	//UI::render(); //calls the render method from the base class
 	StartButton.render();
 	if(canContinue) ContinueButton.render();
+	if(canContinue && hasSummary) Summary.render((WIDTH-Summary.getWidth())/2,HEIGHT-VERT_OFFSET-BUTTON_HEIGHT*2);
 	QuitButton.render();
 }
@@ -19,10 +19,13 @@ public:
 	virtual void fadeOut();
 	virtual int eventHandler(SDL_Event& e);
 	virtual void render();
-	void setContinue(bool canContinue);
+	void setContinue(bool canContinue, string summary = string());
 private:
 	//Flag to draw continue button
 	bool canContinue;
+	//Saved game summary drawn under the continue button
+	Texture Summary;
+	bool hasSummary;
 	Button StartButton;
 	Button ContinueButton;
 	Button QuitButton;
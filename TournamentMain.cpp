@@ -0,0 +1,380 @@
+///ludo-tournament - bot tournaments on a work-stealing thread pool with Elo ratings
+///Usage:
+///  ludo-tournament BOTS [--format round-robin|swiss] [--rounds N] [--threads N]
+///                  [--seed S] [--out FILE]
+
+#include "Strategy.h"
+#include "WorkPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+//Turns after which a game is stopped (unfinished players share the last place)
+#define TURN_LIMIT 100000
+
+//Stop request (SIGINT / SIGTERM)
+static std::atomic<bool> gbStop(false);
+
+static void onSignal(int){
+	gbStop = 1;
+}
+
+
+
+
+//Result of one game
+struct Result{
+	unsigned long long index;
+	//Bots and finish places by turn position
+	int bots[PLAYERS];
+	int places[PLAYERS];
+	int turns;
+};
+
+//Pairwise scores and totals of a set of games
+struct Tally{
+	//wins[i][j]: games bot i finished ahead of bot j (ties count half)
+	vector<vector<double> > wins;
+	vector<long long> games, firsts;
+	vector<double> places;
+
+	Tally(int bots = 0)
+	:wins(bots, vector<double>(bots, 0)), games(bots, 0), firsts(bots, 0), places(bots, 0){}
+
+	void add(const Result& r){
+		for(int i = 0; i < PLAYERS; ++i){
+			int a = r.bots[i];
+			games[a]++;
+			places[a] += r.places[i];
+			if(r.places[i]==1) firsts[a]++;
+			for(int j = 0; j < PLAYERS; ++j){
+				if(i==j) continue;
+				if(r.places[i]<r.places[j]) wins[a][r.bots[j]] += 1;
+				else if(r.places[i]==r.places[j]) wins[a][r.bots[j]] += 0.5;
+			}
+		}
+	}
+
+	void add(const Tally& t){
+		for(unsigned i = 0; i < wins.size(); ++i){
+			for(unsigned j = 0; j < wins.size(); ++j) wins[i][j] += t.wins[i][j];
+			games[i] += t.games[i];
+			firsts[i] += t.firsts[i];
+			places[i] += t.places[i];
+		}
+	}
+};
+
+//Rating with 95% confidence interval
+struct Rating{
+	double elo, interval;
+};
+
+//Bradley-Terry ratings of the pairwise scores on the Elo scale (mean 1500)
+//(a half win prior against every bot keeps unbeaten bots finite)
+static vector<Rating> rate(const Tally& t){
+	int n = t.wins.size();
+	vector<double> strength(n, 1);
+	for(int iteration = 0; iteration < 1000; ++iteration){
+		double change = 0, logSum = 0;
+		vector<double> next(n);
+		for(int i = 0; i < n; ++i){
+			double won = 0, expected = 0;
+			for(int j = 0; j < n; ++j){
+				if(i==j) continue;
+				won += t.wins[i][j]+0.5;
+				expected += (t.wins[i][j]+t.wins[j][i]+1)/(strength[i]+strength[j]);
+			}
+			next[i] = won/expected;
+			logSum += log(next[i]);
+		}
+		for(int i = 0; i < n; ++i){
+			next[i] /= exp(logSum/n);
+			change = std::max(change, fabs(log(next[i]/strength[i])));
+		}
+		strength = next;
+		if(change<1e-9) break;
+	}
+
+	//Standard error from the Fisher information of each rating
+	vector<Rating> ratings(n);
+	double scale = 400/log(10.0);
+	for(int i = 0; i < n; ++i){
+		double information = 0;
+		for(int j = 0; j < n; ++j){
+			if(i==j) continue;
+			double p = strength[i]/(strength[i]+strength[j]);
+			information += (t.wins[i][j]+t.wins[j][i]+1)*p*(1-p);
+		}
+		ratings[i].elo = 1500+scale*log(strength[i]);
+		ratings[i].interval = 1.96*scale/sqrt(information);
+	}
+	return ratings;
+}
+
+
+
+
+//Play one game
+static Result play(unsigned long long index, const int bots[PLAYERS], int rotation,
+                   const vector<Strategy>& strategies, unsigned seed){
+	Result r;
+	r.index = index;
+	vector<Colors> order;
+	for(int i = 0; i < PLAYERS; ++i){
+		r.bots[i] = bots[i];
+		order.push_back(Colors((i+rotation)%PLAYERS+1));
+	}
+	Engine engine;
+	engine.newGame(order);
+	std::minstd_rand dice(seed), ties(seed^0x5bd1e995u);
+	std::uniform_int_distribution<int> die(1, 6);
+	while(!engine.isOver() && engine.getTurn()<TURN_LIMIT){
+		engine.setRoll(die(dice));
+		vector<int> moves = engine.getMoves();
+		int seat = (engine.getCurrent()-1-rotation+PLAYERS)%PLAYERS;
+		if(moves.size()<=1) engine.move(moves.empty() ? PASS : moves[0]);
+		else engine.move(strategies[bots[seat]].pick(engine, moves, ties));
+	}
+	for(unsigned i = 0; i < engine.getPlayers().size(); ++i){
+		const PlayerRecord& p = engine.getPlayers()[i];
+		int seat = (p.color-1-rotation+PLAYERS)%PLAYERS;
+		r.places[seat] = p.finished ? p.finished : PLAYERS;
+	}
+	r.turns = engine.getTurn();
+	return r;
+}
+
+//Groups of bots playing each other in a round
+static vector<vector<int> > schedule(bool swiss, int bots, const vector<Rating>& ratings){
+	vector<vector<int> > groups;
+	//Swiss: neighbours in the standings (the last group overlaps if bots do not divide evenly)
+	if(swiss){
+		vector<int> standings(bots);
+		for(int i = 0; i < bots; ++i) standings[i] = i;
+		std::stable_sort(standings.begin(), standings.end(),
+		                 [&ratings](int a, int b){ return ratings[a].elo>ratings[b].elo; });
+		for(int start = 0; start < bots; start += PLAYERS){
+			int first = std::min(start, bots-PLAYERS);
+			groups.push_back(vector<int>(standings.begin()+first, standings.begin()+first+PLAYERS));
+		}
+		return groups;
+	}
+	//Round-robin: every combination of bots
+	vector<bool> chosen(bots, 0);
+	std::fill(chosen.begin(), chosen.begin()+PLAYERS, 1);
+	do {
+		vector<int> group;
+		for(int i = 0; i < bots; ++i)
+			if(chosen[i]) group.push_back(i);
+		groups.push_back(group);
+	} while(std::prev_permutation(chosen.begin(), chosen.end()));
+	return groups;
+}
+
+//Read saved results (returns 0 if the file belongs to another tournament)
+static bool resume(const string& path, const string& header, const vector<Strategy>& strategies,
+                   unsigned long long gamesPerRound, vector<vector<bool> >& done, vector<Tally>& tallies){
+	std::ifstream in(path.c_str());
+	if(!in) return 1;
+	string line;
+	if(!getline(in, line)) return 1;
+	if(line!=header){
+		cerr << "Tournament error: " << path << " was written with other bots or settings" << endl;
+		return 0;
+	}
+	long long loaded = 0;
+	while(getline(in, line)){
+		//Lines cut short by an interruption are played again
+		std::istringstream fields(line);
+		Result r;
+		string names[PLAYERS];
+		bool valid = (bool)(fields >> r.index);
+		for(int i = 0; i < PLAYERS && valid; ++i){
+			valid = (bool)(fields >> names[i]);
+			r.bots[i] = 0;
+			while(r.bots[i] < (int)strategies.size() && strategies[r.bots[i]].getName()!=names[i]) r.bots[i]++;
+			if(r.bots[i]==(int)strategies.size()) valid = 0;
+		}
+		for(int i = 0; i < PLAYERS && valid; ++i)
+			valid = (fields >> r.places[i]) && r.places[i]>=1 && r.places[i]<=PLAYERS;
+		valid = valid && (fields >> r.turns);
+		unsigned long long round = valid ? r.index/gamesPerRound : 0;
+		if(!valid || round>=done.size() || done[round][r.index%gamesPerRound]) continue;
+		done[round][r.index%gamesPerRound] = 1;
+		tallies[round].add(r);
+		loaded++;
+	}
+	if(loaded) cout << "Resuming with " << loaded << " saved games" << endl;
+	return 1;
+}
+
+
+
+
+int main(int argc, char* argv[]){
+	string botsPath, outPath = "tournament.txt", format = "round-robin";
+	int rounds = 1;
+	int threads = thread::hardware_concurrency();
+	unsigned seed = 1;
+
+	//Read command line options
+	bool usage = argc<2;
+	for(int i = 1; i < argc && !usage; ++i){
+		string arg = argv[i];
+		if(arg=="--format" && i+1<argc) format = argv[++i];
+		else if(arg=="--rounds" && i+1<argc) rounds = atoi(argv[++i]);
+		else if(arg=="--threads" && i+1<argc) threads = atoi(argv[++i]);
+		else if(arg=="--seed" && i+1<argc) seed = strtoul(argv[++i], NULL, 0);
+		else if(arg=="--out" && i+1<argc) outPath = argv[++i];
+		else if(botsPath.empty() && arg[0]!='-') botsPath = arg;
+		else usage = 1;
+	}
+	if(usage || botsPath.empty() || (format!="round-robin" && format!="swiss") || rounds<1){
+		cerr << "Usage: " << argv[0] << " BOTS [--format round-robin|swiss] [--rounds N] [--threads N]" << endl
+		     << "       " << string(string(argv[0]).size(), ' ') << "      [--seed S] [--out FILE]" << endl;
+		return 1;
+	}
+	bool swiss = format=="swiss";
+
+	//Read bots ("NAME [FEATURE=WEIGHT]..." per line, # starts a comment)
+	vector<Strategy> strategies;
+	std::ifstream botsFile(botsPath.c_str());
+	if(!botsFile){
+		cerr << "Tournament error: cannot read " << botsPath << endl;
+		return 1;
+	}
+	string line;
+	for(int number = 1; getline(botsFile, line); ++number){
+		line = line.substr(0, line.find('#'));
+		if(line.find_first_not_of(" \t\r")==string::npos) continue;
+		Strategy s;
+		if(!s.parse(line)){
+			cerr << "Tournament error: " << botsPath << ":" << number << ": bad bot configuration" << endl;
+			return 1;
+		}
+		for(unsigned i = 0; i < strategies.size(); ++i){
+			if(strategies[i].getName()==s.getName()){
+				cerr << "Tournament error: bot " << s.getName() << " is defined twice" << endl;
+				return 1;
+			}
+		}
+		strategies.push_back(s);
+	}
+	int bots = strategies.size();
+	if(bots<PLAYERS){
+		cerr << "Tournament error: at least " << PLAYERS << " bots are needed" << endl;
+		return 1;
+	}
+
+	//Every group plays each seat order with each color rotation
+	vector<vector<int> > orders;
+	vector<int> order(PLAYERS);
+	for(int i = 0; i < PLAYERS; ++i) order[i] = i;
+	do orders.push_back(order); while(std::next_permutation(order.begin(), order.end()));
+	unsigned long long block = orders.size()*PLAYERS;
+	unsigned long long gamesPerRound = schedule(swiss, bots, vector<Rating>(bots)).size()*block;
+
+	//Results file starts with the settings, then one game per line:
+	//INDEX BOT BOT BOT PLACE PLACE PLACE TURNS (bots in turn order)
+	std::ostringstream settings;
+	settings << "# ludo-tournament " << format << " seed " << seed;
+	for(int i = 0; i < bots; ++i) settings << " | " << strategies[i].describe();
+	string header = settings.str();
+	vector<vector<bool> > done(rounds, vector<bool>(gamesPerRound, 0));
+	vector<Tally> tallies(rounds, Tally(bots));
+	if(!resume(outPath, header, strategies, gamesPerRound, done, tallies)) return 1;
+	std::ifstream existing(outPath.c_str(), std::ios::binary | std::ios::ate);
+	bool fresh = !existing || existing.tellg()<=0;
+	bool cut = 0;
+	if(!fresh){
+		existing.seekg(-1, std::ios::end);
+		cut = existing.get()!='\n';
+	}
+	std::ofstream out(outPath.c_str(), std::ios::app);
+	if(!out){
+		cerr << "Tournament error: cannot write " << outPath << endl;
+		return 1;
+	}
+	if(fresh) out << header << '\n';
+	else if(cut) out << '\n';
+
+	signal(SIGINT, onSignal);
+	signal(SIGTERM, onSignal);
+	WorkPool pool(threads);
+	mutex resultLock;
+	cout << "ludo-tournament: " << bots << " bots, " << format << ", " << rounds << " rounds of "
+	     << gamesPerRound << " games, " << pool.getThreads() << " threads" << endl;
+
+	for(int round = 0; round < rounds && !gbStop; ++round){
+		//Swiss groups follow the standings of the finished rounds
+		Tally standings(bots);
+		for(int i = 0; i < round; ++i) standings.add(tallies[i]);
+		vector<vector<int> > groups = schedule(swiss, bots, swiss ? rate(standings) : vector<Rating>(bots));
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		std::atomic<long long> played(0);
+		for(unsigned g = 0; g < groups.size(); ++g){
+			for(unsigned long long k = 0; k < block; ++k){
+				unsigned long long game = g*block+k;
+				if(done[round][game]) continue;
+				unsigned long long index = round*gamesPerRound+game;
+				int seated[PLAYERS];
+				for(int i = 0; i < PLAYERS; ++i) seated[i] = groups[g][orders[k/PLAYERS][i]];
+				int rotation = k%PLAYERS;
+				unsigned gameSeed = seed^(unsigned)(index*2654435761u)^(unsigned)(index>>32);
+				pool.push([&, index, seated, rotation, gameSeed, round](){
+					if(gbStop) return;
+					Result r = play(index, seated, rotation, strategies, gameSeed);
+					std::lock_guard<mutex> lock(resultLock);
+					out << r.index;
+					for(int i = 0; i < PLAYERS; ++i) out << ' ' << strategies[r.bots[i]].getName();
+					for(int i = 0; i < PLAYERS; ++i) out << ' ' << r.places[i];
+					out << ' ' << r.turns << '\n';
+					tallies[round].add(r);
+					played++;
+				});
+			}
+		}
+		pool.wait();
+		out.flush();
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+		cout << "Round " << round+1 << "/" << rounds << ": " << played << " games";
+		if(played) cout << ", " << int(played/seconds) << " games/s";
+		cout << endl;
+	}
+
+	//Standings
+	Tally total(bots);
+	for(int i = 0; i < rounds; ++i) total.add(tallies[i]);
+	vector<Rating> ratings = rate(total);
+	vector<int> ranking(bots);
+	for(int i = 0; i < bots; ++i) ranking[i] = i;
+	std::sort(ranking.begin(), ranking.end(), [&ratings](int a, int b){ return ratings[a].elo>ratings[b].elo; });
+	cout << endl << std::left << std::setw(6) << "Rank" << std::setw(16) << "Bot" << std::setw(14) << "Elo (95%)"
+	     << std::setw(10) << "Games" << std::setw(8) << "Place" << "First" << endl;
+	for(int i = 0; i < bots; ++i){
+		int b = ranking[i];
+		std::ostringstream elo;
+		elo << int(lround(ratings[b].elo)) << " +-" << int(lround(ratings[b].interval));
+		cout << std::setw(6) << i+1 << std::setw(16) << strategies[b].getName() << std::setw(14) << elo.str()
+		     << std::setw(10) << total.games[b] << std::fixed << std::setprecision(2)
+		     << std::setw(8) << (total.games[b] ? total.places[b]/total.games[b] : 0)
+		     << std::setprecision(1) << (total.games[b] ? 100.0*total.firsts[b]/total.games[b] : 0) << "%" << endl;
+	}
+	if(gbStop){
+		cout << "Interrupted: finished games are saved in " << outPath << ", run the same command to resume" << endl;
+		return 1;
+	}
+	return 0;
+}
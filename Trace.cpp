@@ -0,0 +1,107 @@
+#include "Trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+#include <mutex>
+#include <vector>
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::vector;
+
+//Ring buffer of one thread (only that thread writes it, fields are atomic
+//so a dump can read while the thread overwrites the oldest events)
+struct TraceEvent{
+	std::atomic<const char*> name;
+	std::atomic<long long> start, end;
+};
+struct TraceCopy{
+	const char* name;
+	long long start, end;
+};
+struct TraceBuffer{
+	TraceEvent events[TRACE_EVENTS];
+	//Events written so far (the event is complete before the count is published)
+	std::atomic<unsigned long long> written;
+	int thread;
+};
+
+//Buffers of every thread that recorded an event (kept after the thread ends)
+static vector<TraceBuffer*> buffers;
+static std::mutex buffersLock;
+
+//Time origin of the trace
+static long long origin = Trace::now();
+
+void Trace::record(const char* name, long long start, long long end){
+	static thread_local TraceBuffer* buffer = NULL;
+	if(buffer==NULL){
+		buffer = new TraceBuffer;
+		buffer->written = 0;
+		std::lock_guard<std::mutex> lock(buffersLock);
+		buffer->thread = buffers.size()+1;
+		buffers.push_back(buffer);
+	}
+	unsigned long long i = buffer->written.load(std::memory_order_relaxed);
+	TraceEvent& e = buffer->events[i%TRACE_EVENTS];
+	e.name.store(name, std::memory_order_relaxed);
+	e.start.store(start, std::memory_order_relaxed);
+	e.end.store(end, std::memory_order_relaxed);
+	buffer->written.store(i+1, std::memory_order_release);
+}
+
+
+
+
+bool Trace::dump(){
+	char path[64];
+	time_t t = time(NULL);
+	strftime(path, sizeof(path), "trace-%Y%m%d-%H%M%S.json", localtime(&t));
+	return dump(path);
+}
+
+bool Trace::dump(const string& path){
+	FILE* out = fopen(path.c_str(), "w");
+	if(out==NULL){
+		cerr << "Trace error: cannot write " << path << endl;
+		return 0;
+	}
+	std::lock_guard<std::mutex> lock(buffersLock);
+	fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+	int events = 0;
+	for(unsigned b = 0; b < buffers.size(); ++b){
+		TraceBuffer* buffer = buffers[b];
+		fprintf(out, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s %d\"}}",
+		        b ? "," : "", buffer->thread, buffer->thread==1 ? "main" : "thread", buffer->thread);
+
+		//Copy the buffer, then drop events its thread overwrote meanwhile
+		unsigned long long written = buffer->written.load(std::memory_order_acquire);
+		unsigned long long first = written>TRACE_EVENTS ? written-TRACE_EVENTS : 0;
+		vector<TraceCopy> copy;
+		for(unsigned long long i = first; i < written; ++i){
+			const TraceEvent& e = buffer->events[i%TRACE_EVENTS];
+			TraceCopy c = {e.name.load(std::memory_order_relaxed), e.start.load(std::memory_order_relaxed),
+			               e.end.load(std::memory_order_relaxed)};
+			copy.push_back(c);
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		unsigned long long after = buffer->written.load(std::memory_order_acquire);
+		unsigned long long valid = after>TRACE_EVENTS ? after-TRACE_EVENTS : 0;
+
+		for(unsigned long long i = std::max(first, valid); i < written; ++i){
+			const TraceCopy& e = copy[i-first];
+			fprintf(out, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+			        e.name, buffer->thread, (e.start-origin)/1000.0, (e.end-e.start)/1000.0);
+			events++;
+		}
+	}
+	fprintf(out, "\n]}\n");
+	bool ok = !ferror(out);
+	if(fclose(out)!=0) ok = 0;
+	if(!ok) cerr << "Trace error: cannot write " << path << endl;
+	else cout << "Trace written to " << path << " (" << events << " events)" << endl;
+	return ok;
+}
@@ -0,0 +1,69 @@
+///Scoped trace events written as Chrome trace JSON (TRACE builds, open in ui.perfetto.dev or chrome://tracing)
+///TRACE_SCOPE("name") times the rest of the enclosing block; without TRACE it compiles to nothing
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#ifdef TRACE
+
+///Events kept per thread (older events are overwritten)
+#define TRACE_EVENTS 65536
+
+///Misc library inclusion
+#include <chrono>
+#include <string>
+using std::string;
+
+class Trace{
+public:
+
+	///Scope timer
+	class Scope{
+	public:
+
+		///Start timing
+		///Args:
+		///const char* name - event name (a string literal, it is not copied)
+		Scope(const char* name): mName(name), miStart(now()){}
+
+		///Record the event
+		~Scope(){ record(mName, miStart, now()); }
+
+	private:
+
+		const char* mName;
+		long long miStart;
+	};
+
+	///Write the events of every thread to a new trace-DATE-TIME.json (returns 0 on failure)
+	static bool dump();
+
+	///Write the events of every thread
+	///Args:
+	///const string& path - output file
+	static bool dump(const string& path);
+
+	///Current time (in ns)
+	static long long now(){
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	///Add an event to the buffer of the calling thread
+	///Args:
+	///const char* name - event name
+	///long long start - start time (ns)
+	///long long end - end time (ns)
+	static void record(const char* name, long long start, long long end);
+};
+
+#define TRACE_JOIN(a, b) a##b
+#define TRACE_NAME(line) TRACE_JOIN(traceScope, line)
+#define TRACE_SCOPE(name) Trace::Scope TRACE_NAME(__LINE__)(name)
+
+#else
+
+#define TRACE_SCOPE(name)
+
+#endif
+
+#endif
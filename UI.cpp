@@ -3,19 +3,20 @@
 //Constructor
 UI::UI(){
 	//Initialize class data
+	this->mFont = NULL;
 	this->miFontSize = 10;
 	this->msFontPath = string();
 	this->msBackgroundPath = string();
 	this->unload = 1;
-	this->eventTimer = SDL_GetTicks();
+	this->eventTimer = Clock::now();
 }
 
 //Debouncer
 bool UI::debounce(){
 	//If time has passed
-	if((SDL_GetTicks()-eventTimer)>100){
+	if((Clock::now()-eventTimer)>100){
 		//Update timer
-		eventTimer = SDL_GetTicks();
+		eventTimer = Clock::now();
 		return 1;
 	}
 	return 0;
@@ -51,6 +52,22 @@ void UI::loadBackground(string backgroundPath){
 	}
 }
 
+//Button registration
+void UI::addButton(Button& b, int id){
+	mHits.add(b.getRect(), id);
+	mButtons[id] = &b;
+}
+
+//Clicked button lookup
+int UI::clicked(SDL_Event& e){
+	if(e.type != SDL_MOUSEBUTTONDOWN || e.button.button != SDL_BUTTON_LEFT) return 0;
+	//Find button under the event position
+	int id = mHits.find(e.button.x, e.button.y);
+	//Let the button confirm the click (plays its SFX)
+	if(id && mButtons[id]->isClicked(e)) return id;
+	return 0;
+}
+
 //Font getter
 TTF_Font* UI::getFont() const {
 	return mFont;
@@ -6,6 +6,10 @@
 ///Include local libraries
 #include "Button.h"
 #include "Shared.h"
+#include "HitGrid.h"
+#include "Clock.h"
+#include <map>
+using std::map;
 
 class UI{
 public:
@@ -53,6 +57,21 @@ public:
 	///Destructor
 	virtual ~UI();
 
+protected:
+
+	///Register button for hit testing (call after placing it)
+	///Args:
+	///Button& b - button
+	///int id - button state bit
+	void addButton(Button& b, int id);
+
+	///Clicked button check
+	///Args:
+	///SDL_Event& e - reference to SDL event container
+	///Returns:
+	///state bit of the clicked button (0 if none)
+	int clicked(SDL_Event& e);
+
 private:
 	
 	///Font object pointer
@@ -75,6 +94,12 @@ private:
 
 	///Event debounce timer
 	Uint32 eventTimer;
+
+	///Button hit index
+	HitGrid mHits;
+
+	///Registered buttons by state bit
+	map<int, Button*> mButtons;
 };
 
 #endif
@@ -41,6 +41,10 @@ void WinScreen::init()
 	// set the size on the buttons
 	m_bRestart.setSize(BUTTON_WIDTH, BUTTON_HEIGHT);
 	m_BQuit.setSize(BUTTON_WIDTH, BUTTON_HEIGHT);
+
+	// register the buttons for hit testing
+	UI::addButton(m_bRestart, WIN_RESTART);
+	UI::addButton(m_BQuit, WIN_QUIT);
 }
 
 void WinScreen::render()
@@ -93,11 +97,8 @@ int WinScreen::eventHandler(SDL_Event& e)
 	// on the value of the integer with the returned value
 	// of method on the restart button responsible for checking
 	// the state (clicked or not) of the button
-	ButtonState |= m_bRestart.isClicked(e);
-	// than shift the bits in the variable to make room for the other value
-	ButtonState <<= 1;
-	// do the same thing with the quit button
-	ButtonState |= m_BQuit.isClicked(e);
+	// the state bit of the clicked button (if any)
+	ButtonState = UI::clicked(e);
 
 	}
 	// than return the variable with the correct arranged data
@@ -128,7 +129,7 @@ string WinScreen::ColorToString(Colors color)
 	}
 }
 
-void WinScreen::loadData(deque<Player*> data)
+void WinScreen::loadData(const deque<Player*>& data)
 {
 	// make a stringstream variable in which
 	// we are going to fill the data for the players
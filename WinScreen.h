@@ -39,7 +39,7 @@ public:
 	virtual int eventHandler(SDL_Event& e);
 	virtual void fadeIn();
 	virtual void fadeOut();
-	void loadData(deque<Player*>);
+	void loadData(const deque<Player*>&);
 };
 
 #endif /* WINSCREEN_H_ */
@@ -0,0 +1,102 @@
+#include "WorkPool.h"
+
+//Constructor
+WorkPool::WorkPool(int threads)
+:miNext(0), miPending(0), mbStop(false){
+	if(threads<1) threads = 1;
+	for(int i = 0; i < threads; ++i)
+		mQueues.push_back(new Queue);
+	for(int i = 0; i < threads; ++i)
+		mThreads.push_back(thread(&WorkPool::run, this, i));
+}
+
+//Destructor
+WorkPool::~WorkPool(){
+	wait();
+	{
+		std::lock_guard<mutex> lock(mIdleLock);
+		mbStop = 1;
+	}
+	mWork.notify_all();
+	for(unsigned i = 0; i < mThreads.size(); ++i)
+		mThreads[i].join();
+	for(unsigned i = 0; i < mQueues.size(); ++i)
+		delete mQueues[i];
+}
+
+//Queue task
+void WorkPool::push(const std::function<void()>& task){
+	miPending++;
+	Queue* q = mQueues[miNext++ % mQueues.size()];
+	{
+		std::lock_guard<mutex> lock(q->lock);
+		q->tasks.push_back(task);
+	}
+	//Lock so a worker cannot miss the wake up between its check and its sleep
+	std::lock_guard<mutex> lock(mIdleLock);
+	mWork.notify_one();
+}
+
+//Wait for queued tasks
+void WorkPool::wait(){
+	std::unique_lock<mutex> lock(mIdleLock);
+	mDone.wait(lock, [this]{ return miPending==0; });
+}
+
+//Getters
+int WorkPool::getThreads() const {
+	return mThreads.size();
+}
+
+
+
+
+//Worker loop
+void WorkPool::run(int index){
+	std::function<void()> task;
+	while(1){
+		if(take(index, task)){
+			task();
+			task = nullptr;
+			if(--miPending==0){
+				std::lock_guard<mutex> lock(mIdleLock);
+				mDone.notify_all();
+			}
+			continue;
+		}
+		//Sleep until new tasks are pushed
+		std::unique_lock<mutex> lock(mIdleLock);
+		if(mbStop) return;
+		bool queued = 0;
+		for(unsigned i = 0; i < mQueues.size() && !queued; ++i){
+			std::lock_guard<mutex> q(mQueues[i]->lock);
+			queued = !mQueues[i]->tasks.empty();
+		}
+		if(!queued) mWork.wait(lock);
+	}
+}
+
+//Take task
+bool WorkPool::take(int index, std::function<void()>& task){
+	//Own queue, newest first
+	{
+		Queue* q = mQueues[index];
+		std::lock_guard<mutex> lock(q->lock);
+		if(!q->tasks.empty()){
+			task = q->tasks.back();
+			q->tasks.pop_back();
+			return 1;
+		}
+	}
+	//Steal the oldest task of another worker
+	for(unsigned i = 1; i < mQueues.size(); ++i){
+		Queue* q = mQueues[(index+i) % mQueues.size()];
+		std::lock_guard<mutex> lock(q->lock);
+		if(!q->tasks.empty()){
+			task = q->tasks.front();
+			q->tasks.pop_front();
+			return 1;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,78 @@
+///Work-stealing thread pool (no SDL, used by ludo-tournament)
+
+#ifndef WORKPOOL_H
+#define WORKPOOL_H
+
+///Misc library inclusion
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+using std::deque;
+#include <functional>
+#include <mutex>
+using std::mutex;
+#include <thread>
+using std::thread;
+#include <vector>
+using std::vector;
+
+///Every worker takes tasks from the back of its own queue and steals from the
+///front of the others once it runs dry, so uneven task lengths (long and short
+///matches) do not leave threads idle
+class WorkPool{
+public:
+
+	///Constructor (starts the threads)
+	///Args:
+	///int threads - worker threads
+	WorkPool(int threads);
+
+	///Destructor (finishes queued tasks and stops the threads)
+	~WorkPool();
+
+	///Queue a task (queues are filled in turn)
+	///Args:
+	///const std::function<void()>& task - task
+	void push(const std::function<void()>& task);
+
+	///Wait until all queued tasks are done
+	void wait();
+
+	///Getters
+	int getThreads() const;
+
+private:
+
+	///Tasks of one worker
+	struct Queue{
+		mutex lock;
+		deque<std::function<void()> > tasks;
+	};
+
+	///Worker loop
+	///Args:
+	///int index - worker index
+	void run(int index);
+
+	///Take own or stolen task (returns 0 if all queues are empty)
+	bool take(int index, std::function<void()>& task);
+
+	///Worker queues and threads
+	vector<Queue*> mQueues;
+	vector<thread> mThreads;
+
+	///Queue of the next pushed task
+	unsigned miNext;
+
+	///Queued and running tasks
+	std::atomic<int> miPending;
+
+	///Stop flag
+	std::atomic<bool> mbStop;
+
+	///Sleeping workers and waiting callers
+	mutex mIdleLock;
+	std::condition_variable mWork, mDone;
+};
+
+#endif
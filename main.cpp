@@ -6,6 +6,10 @@
 //Include local modules
 #include "Game.h"
 #include "SDL_Manager.h"
+#include "Clock.h"
+#ifdef HOT_RELOAD
+#include "HotReload.h"
+#endif
 
 
 //-----------------------------
@@ -32,11 +36,14 @@ Game game;
 
 
 //SDL initializing function
-void init();
+void init(bool vsync, int audioBuffer);
 
 //Event handler
 void eventHandler();
 
+//Pass event to game
+void handleEvent();
+
 
 //-----------------------------
 //------------MAIN-------------
@@ -49,31 +56,140 @@ int main(int argc, char* argv[]){
 	cout << "========= DEBUG MODE =========" << endl;
 #endif
 	
-	//Unused warning elimination
-	argc = 0; argv = 0;
+	//Read command line options
+	const char* recordPath = NULL;
+	const char* playPath = NULL;
+	bool fast = 0;
+	int audioBuffer = AUDIO_BUFFER;
+	const char* connectAddress = NULL;
+	const char* hostAddress = NULL;
+	const char* peerAddress = NULL;
+	int match = 0;
+	bool watch = 0;
+	int benchFrames = 0;
+	string metricsAddress, metricsFile;
+	bool usage = 0;
+	for(int i = 1; i < argc; ++i){
+		string arg = argv[i];
+		if(arg=="--record" && i+1<argc) recordPath = argv[++i];
+		else if(arg=="--play" && i+1<argc) playPath = argv[++i];
+		else if(arg=="--fast") fast = 1;
+		else if(arg=="--audio-buffer" && i+1<argc) audioBuffer = atoi(argv[++i]);
+		else if(arg=="--connect" && i+1<argc) connectAddress = argv[++i];
+		else if(arg=="--match" && i+1<argc) match = atoi(argv[++i]);
+		else if(arg=="--watch") watch = 1;
+		else if(arg=="--host" && i+1<argc) hostAddress = argv[++i];
+		else if(arg=="--peer" && i+1<argc) peerAddress = argv[++i];
+		else if(arg=="--render-bench" && i+1<argc) benchFrames = atoi(argv[++i]);
+		else if(arg=="--metrics" && i+1<argc) metricsAddress = argv[++i];
+		else if(arg=="--metrics-file" && i+1<argc) metricsFile = argv[++i];
+		else {
+			usage = 1;
+			break;
+		}
+	}
+	//Server and peer moves cannot be recorded or replayed
+	int online = (connectAddress!=NULL)+(hostAddress!=NULL)+(peerAddress!=NULL);
+	if(usage || online>1 || (online && (recordPath || playPath)) || (watch && !connectAddress)
+	   || (benchFrames && (online || recordPath || playPath))){
+		cerr << "Usage: " << argv[0] << " [--record FILE | --play FILE [--fast] | --connect ADDRESS [--match N] [--watch]"
+		     << " | --host ADDRESS | --peer ADDRESS | --render-bench FRAMES] [--audio-buffer SAMPLES]"
+		     << " [--metrics SOCKET] [--metrics-file FILE]" << endl;
+		return 1;
+	}
+
+	//Render benchmark (no window or sound device needed unless SDL_VIDEODRIVER says otherwise)
+	if(benchFrames){
+		SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+		SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+		srand(1);
+		Recovery::enabled = 0;
+		init(0, audioBuffer);
+		Clock::start(0);
+		bool ok = game.benchmark(benchFrames);
+		Sound::free();
+#ifdef HOT_RELOAD
+		HotReload::free();
+#endif
+		return ok ? 0 : 1;
+	}
+
+	//Seed RNG once (playback reuses the recorded seed)
+	Uint32 seed = time(0);
+	if(playPath){
+		if(!Replay::play(playPath, seed)) return 1;
+	} else if(recordPath && !Replay::record(recordPath, seed)) return 1;
+	srand(seed);
+	//Replays and online matches keep the saved game intact
+	if(playPath || recordPath || online) Recovery::enabled = 0;
 
-	//Initialize SDL
-	init();
+	//Initialize SDL (fast playback is not limited by the display)
+	init(!(playPath && fast), audioBuffer);
+
+	//Join online match
+	if(connectAddress && !game.connect(connectAddress, match, watch)) return 1;
+	//Host or join lockstep match
+	if((hostAddress || peerAddress) && !game.lockstep(hostAddress ? hostAddress : peerAddress, hostAddress!=NULL)) return 1;
+	//Serve metrics
+	if((!metricsAddress.empty() || !metricsFile.empty()) && !Metrics::start(metricsAddress, metricsFile)) return 1;
 
 	//Game loop
+	Clock::start(!fast);
 	while(!quit){
+#ifdef HOT_RELOAD
+		//Apply changed constants and assets between frames
+		HotReload::poll();
+#endif
+
+		//Advance frame clock (stops at the end of a played recording)
+		if(!Clock::tick()) break;
+		Profiler::frame();
+		Metrics::frame();
+
+		//Fall back to a safe audio buffer on underruns
+		manager.updateAudio();
+
 		//Handle events
+		Profiler::begin(PHASE_EVENTS);
 		eventHandler();
+		Profiler::end(PHASE_EVENTS);
 
 		//Loop game
 		game.loop();
 
 		//Render on screen
+		Profiler::begin(PHASE_PRESENT);
 		SDL_RenderPresent(manager.getRenderer());
+		Profiler::end(PHASE_PRESENT);
 	}
 
 #ifdef DEBUG
 	cout << "Game loop broken" << endl;
 #endif
+
+	//Report playback speed
+	if(playPath)
+		cout << "Replayed " << Replay::frames() << " frames in " << Clock::elapsed() << " ms" << endl;
+	//Report resident assets
+	Resources::report(cout);
+	//Finish replay file
+	Replay::close();
+	//Stop serving metrics
+	Metrics::stop();
     
     //Release sound
 	Sound::free();
 
+#ifdef HOT_RELOAD
+	//Stop watching files
+	HotReload::free();
+#endif
+
+#ifdef TRACE
+	//Write trace of the last frames
+	Trace::dump();
+#endif
+
 #ifdef DEBUG
 	cout << "========= SUCCESSFUL EXIT =========" << endl;
 #endif
@@ -89,12 +205,14 @@ int main(int argc, char* argv[]){
 
 
 //SDL inititalizing function
-void init(){
+void init(bool vsync, int audioBuffer){
 	
 #ifdef DEBUG
 	cout << "Init called" << endl;
 #endif
 
+    //Initialize SDL, window and renderer
+    manager.init(vsync, audioBuffer);
     Texture::mRenderer = manager.getRenderer();
     //Initialize sound
     Sound::load();
@@ -102,6 +220,10 @@ void init(){
     game.setEvent(event);
     //Initialize game data
     game.init();
+#ifdef HOT_RELOAD
+    //Watch constants and assets
+    HotReload::init();
+#endif
 }
 
 //Event handler
@@ -112,11 +234,29 @@ void eventHandler(){
 #endif
     
 	while(SDL_PollEvent(&event)!=0){
-		//Application quit event
-		if(event.type == SDL_QUIT || event.key.keysym.sym == SDLK_ESCAPE){
-			quit = 1;
+		//Live input can only stop playback
+		if(Replay::isPlaying()){
+			if(event.type == SDL_QUIT || (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_ESCAPE)){
+				quit = 1;
+			}
+			continue;
 		}
-		game.setEvent(event);
-		game.eventHandler();
+		Replay::recordEvent(event);
+		handleEvent();
+	}
+	//Feed recorded events of this frame
+	while(Replay::pollEvent(event)){
+		handleEvent();
+	}
+}
+
+//Pass event to game
+void handleEvent(){
+	//Application quit event
+	if(event.type == SDL_QUIT || (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_ESCAPE)){
+		quit = 1;
 	}
+	//Route event to game (once per event)
+	game.setEvent(event);
+	game.eventHandler();
 }
@@ -1 +1,3 @@
-g++ -o ludo.exe main.cpp SDL_Manager.cpp Game.cpp Recovery.cpp Texture.cpp Sprite.cpp Sound.cpp Dice.cpp Player.cpp Pawn.cpp Button.cpp UI.cpp TitleScreen.cpp WinScreen.cpp Info.cpp Controls.cpp pugixml.cpp -IC:\MinGW\include\SDL2 -LC:\MinGW\lib -lmingw32 -lSDL2main -lSDL2 -lSDL2_image -lSDL2_mixer -lSDL2_ttf -Wall -std=c++11
+g++ -o constgen.exe ConstantsGen.cpp pugixml.cpp -Wall -std=c++11
+constgen.exe Constants.xml Constants.h
+g++ -o ludo.exe main.cpp SDL_Manager.cpp Game.cpp Recovery.cpp Texture.cpp Sprite.cpp Sound.cpp Dice.cpp Player.cpp Pawn.cpp Button.cpp UI.cpp TitleScreen.cpp WinScreen.cpp Info.cpp Controls.cpp Volume.cpp Slider.cpp EventRouter.cpp HitGrid.cpp Clock.cpp Replay.cpp Timeline.cpp AnimationClip.cpp Engine.cpp Net.cpp Protocol.cpp Lockstep.cpp Profiler.cpp Resources.cpp Metrics.cpp pugixml.cpp -IC:\MinGW\include\SDL2 -LC:\MinGW\lib -lmingw32 -lSDL2main -lSDL2 -lSDL2_image -lSDL2_mixer -lSDL2_ttf -Wall -std=c++11